@@ -111,4 +111,153 @@ void genRandomProbData(scs_int nnz, scs_int col_nnz, Data *d, Cone *k,
     scs_free(z);
 }
 
+/* reads a problem in the raw format of examples/raw, the settings are read
+ * from the file too */
+scs_int readInData(FILE *fp, Data *d, Cone *k) {
+    /* MATRIX IN DATA FILE MUST BE IN COLUMN COMPRESSED FORMAT */
+    scs_int i, Anz;
+    AMatrix *A;
+    Settings *stgs = scs_malloc(sizeof(Settings));
+    stgs->rho_x = RHO_X;
+    stgs->warm_start = 0;
+    stgs->polish = 0;
+    stgs->adapt_scale = 0;
+    stgs->adapt_alpha = 0;
+    stgs->stall_stop = 0;
+    stgs->linsys = LINSYS_AUTO;
+    stgs->scale = 1;
+    if (fscanf(fp, INTRW, &(d->n)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(d->m)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(k->f)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(k->l)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(k->qsize)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(k->ssize)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(k->ep)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(k->ed)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(k->psize)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+
+    if (fscanf(fp, INTRW, &(stgs->max_iters)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(stgs->verbose)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, INTRW, &(stgs->normalize)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, FLOATRW, &(stgs->alpha)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, FLOATRW, &(stgs->eps)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, FLOATRW, &(stgs->rho_x)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, FLOATRW, &(stgs->scale)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    if (fscanf(fp, FLOATRW, &(stgs->cg_rate)) != 1) {
+        DEBUG_FUNC
+        return -1;
+    }
+    k->q = malloc(sizeof(scs_int) * k->qsize);
+    for (i = 0; i < k->qsize; i++) {
+        if (fscanf(fp, INTRW, &k->q[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    k->s = malloc(sizeof(scs_int) * k->ssize);
+    for (i = 0; i < k->ssize; i++) {
+        if (fscanf(fp, INTRW, &k->s[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    k->p = malloc(sizeof(scs_float) * k->psize);
+    for (i = 0; i < k->psize; i++) {
+        if (fscanf(fp, FLOATRW, &k->p[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    d->b = malloc(sizeof(scs_float) * d->m);
+    for (i = 0; i < d->m; i++) {
+        if (fscanf(fp, FLOATRW, &d->b[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    d->c = malloc(sizeof(scs_float) * d->n);
+    for (i = 0; i < d->n; i++) {
+        if (fscanf(fp, FLOATRW, &d->c[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    A = calloc(1, sizeof(AMatrix));
+    A->p = malloc(sizeof(scs_int) * (d->n + 1));
+    for (i = 0; i < d->n + 1; i++) {
+        if (fscanf(fp, INTRW, &A->p[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    Anz = A->p[d->n];
+    A->i = malloc(sizeof(scs_int) * Anz);
+    for (i = 0; i < Anz; i++) {
+        if (fscanf(fp, INTRW, &A->i[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    A->x = malloc(sizeof(scs_float) * Anz);
+    for (i = 0; i < Anz; i++) {
+        if (fscanf(fp, FLOATRW, &A->x[i]) != 1) {
+            DEBUG_FUNC
+            return -1;
+        }
+    }
+    A->n = d->n;
+    A->m = d->m;
+    d->A = A;
+    d->stgs = stgs;
+    return 0;
+}
+
 #endif
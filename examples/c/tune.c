@@ -0,0 +1,314 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ offline tuner for the solver settings over a corpus of problems:
+
+ solves every problem in a directory of raw instances (the format of
+ examples/raw) under each point of a grid over normalize, scale, rho_x, alpha
+ and, for the indirect solver, cg_rate, spreading the solves over threads.
+ A point is accurate on an instance if it returns solved, infeasible or
+ unbounded (not inaccurate, not out of iterations). The points accurate on
+ the most instances are ranked by the median, then the 95th percentile, of
+ setup plus solve time over the corpus. The best point is written as a
+ settings profile, lines of "name value", that readSettings (util.h) loads in
+ C and scs.load_settings in python; the instances keep their own eps and
+ max_iters.
+ */
+
+static const scs_float SCALES[] = {0.1, 0.5, 1, 5, 10};
+static const scs_float RHO_XS[] = {1e-4, 1e-3, 1e-2};
+static const scs_float ALPHAS[] = {1.2, 1.5, 1.8};
+#ifdef TUNE_CG_RATE
+static const scs_float CG_RATES[] = {1.5, 2, 3};
+#else
+static const scs_float CG_RATES[] = {CG_RATE};
+#endif
+#define LEN(a) ((scs_int)(sizeof(a) / sizeof(a[0])))
+#define MAX_CONFIGS                                                            \
+    (2 * LEN(SCALES) * LEN(RHO_XS) * LEN(ALPHAS) * LEN(CG_RATES))
+
+typedef struct {
+    char *name;
+    Data *d;
+    Cone *k;
+} Instance;
+
+typedef struct {
+    scs_int normalize;
+    scs_float scale, rho_x, alpha, cg_rate;
+    /* over the corpus */
+    scs_int numAccurate;
+    scs_float median, p95;
+} Config;
+
+/* every (config, instance) pair is one job, taken by the threads in order */
+typedef struct {
+    Instance *inst;
+    scs_int numInst;
+    Config *cfg;
+    scs_int numCfg;
+    scs_float *time; /* setup + solve time of job, ms */
+    scs_int *accurate;
+    scs_int next;
+    pthread_mutex_t lock;
+} Tuner;
+
+static scs_int isAccurate(scs_int statusVal) {
+    return statusVal == SCS_SOLVED || statusVal == SCS_INFEASIBLE ||
+           statusVal == SCS_UNBOUNDED;
+}
+
+static void runJob(Tuner *t, scs_int job) {
+    Config *c = &(t->cfg[job / t->numInst]);
+    Instance *in = &(t->inst[job % t->numInst]);
+    Settings stgs = *(in->d->stgs);
+    Data d = *(in->d);
+    Sol *sol = scs_calloc(1, sizeof(Sol));
+    Info info = {0};
+#ifndef COPYAMATRIX
+    /* A is normalized in place, each job needs its own */
+    AMatrix A = *(in->d->A);
+    scs_int Anz = A.p[A.n];
+    A.x = scs_malloc(Anz * sizeof(scs_float));
+    memcpy(A.x, in->d->A->x, Anz * sizeof(scs_float));
+    d.A = &A;
+#endif
+    stgs.normalize = c->normalize;
+    stgs.scale = c->scale;
+    stgs.rho_x = c->rho_x;
+    stgs.alpha = c->alpha;
+    stgs.cg_rate = c->cg_rate;
+    stgs.verbose = 0;
+    stgs.warm_start = 0;
+    d.stgs = &stgs;
+    scs(&d, in->k, sol, &info);
+    t->time[job] = info.setupTime + info.solveTime;
+    t->accurate[job] = isAccurate(info.statusVal);
+    freeSol(sol);
+#ifndef COPYAMATRIX
+    scs_free(A.x);
+#endif
+}
+
+static void *worker(void *arg) {
+    Tuner *t = (Tuner *)arg;
+    scs_int job;
+    for (;;) {
+        pthread_mutex_lock(&t->lock);
+        job = t->next++;
+        pthread_mutex_unlock(&t->lock);
+        if (job >= t->numCfg * t->numInst) {
+            return SCS_NULL;
+        }
+        runJob(t, job);
+    }
+}
+
+static int cmpFloat(const void *a, const void *b) {
+    scs_float x = *(const scs_float *)a, y = *(const scs_float *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static int cmpString(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* most instances solved accurately first, then median, then p95 time */
+static int cmpConfig(const void *a, const void *b) {
+    const Config *x = (const Config *)a, *y = (const Config *)b;
+    if (x->numAccurate != y->numAccurate) {
+        return x->numAccurate > y->numAccurate ? -1 : 1;
+    }
+    if (x->median != y->median) {
+        return x->median < y->median ? -1 : 1;
+    }
+    return cmpFloat(&(x->p95), &(y->p95));
+}
+
+static scs_int makeConfigs(Config *cfg) {
+    scs_int nm, i, j, l, q, num = 0;
+    for (nm = 1; nm >= 0; --nm) {
+        /* scale is only used with normalization */
+        for (i = 0; i < (nm ? LEN(SCALES) : 1); ++i) {
+            for (j = 0; j < LEN(RHO_XS); ++j) {
+                for (l = 0; l < LEN(ALPHAS); ++l) {
+                    for (q = 0; q < LEN(CG_RATES); ++q) {
+                        cfg[num].normalize = nm;
+                        cfg[num].scale = nm ? SCALES[i] : SCALE;
+                        cfg[num].rho_x = RHO_XS[j];
+                        cfg[num].alpha = ALPHAS[l];
+                        cfg[num].cg_rate = CG_RATES[q];
+                        num++;
+                    }
+                }
+            }
+        }
+    }
+    return num;
+}
+
+/* loads every regular file of dir that reads as a raw instance */
+static scs_int loadInstances(const char *dir, Instance **instp) {
+    DIR *dp = opendir(dir);
+    struct dirent *e;
+    struct stat st;
+    char path[4096], **names = SCS_NULL;
+    scs_int i, num = 0, numNames = 0;
+    Instance *inst;
+    FILE *fp;
+    if (!dp) {
+        printf("couldn't open directory %s\n", dir);
+        return -1;
+    }
+    while ((e = readdir(dp)) != SCS_NULL) {
+        sprintf(path, "%.2000s/%.2000s", dir, e->d_name);
+        if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+            names = realloc(names, (numNames + 1) * sizeof(char *));
+            names[numNames] = malloc(strlen(path) + 1);
+            strcpy(names[numNames++], path);
+        }
+    }
+    closedir(dp);
+    qsort(names, numNames, sizeof(char *), cmpString);
+    inst = scs_calloc(numNames > 0 ? numNames : 1, sizeof(Instance));
+    for (i = 0; i < numNames; ++i) {
+        inst[num].d = scs_calloc(1, sizeof(Data));
+        inst[num].k = scs_calloc(1, sizeof(Cone));
+        inst[num].name = names[i];
+        fp = fopen(names[i], "r");
+        if (fp && readInData(fp, inst[num].d, inst[num].k) == 0) {
+            num++;
+        } else {
+            printf("skipping %s, not a raw instance\n", names[i]);
+            scs_free(inst[num].d);
+            scs_free(inst[num].k);
+            free(names[i]);
+        }
+        if (fp) {
+            fclose(fp);
+        }
+    }
+    free(names);
+    *instp = inst;
+    return num;
+}
+
+static void writeProfile(FILE *fp, const Config *c, scs_int numInst) {
+    fprintf(fp,
+            "# scs settings profile: accurate on %li of %li instances, "
+            "median %.3gms, p95 %.3gms\n",
+            (long)c->numAccurate, (long)numInst, c->median, c->p95);
+    fprintf(fp, "normalize %li\n", (long)c->normalize);
+    fprintf(fp, "scale %g\n", c->scale);
+    fprintf(fp, "rho_x %g\n", c->rho_x);
+    fprintf(fp, "alpha %g\n", c->alpha);
+#ifdef TUNE_CG_RATE
+    fprintf(fp, "cg_rate %g\n", c->cg_rate);
+#endif
+}
+
+int main(int argc, char **argv) {
+    Tuner t;
+    Config cfg[MAX_CONFIGS], *c;
+    pthread_t *threads;
+    scs_float *times;
+    scs_int i, j, numThreads, defaults = -1;
+    FILE *fp;
+
+    if (argc < 2) {
+        printf("usage:\t%s dir [threads] [profile]\n"
+               "\tsolves the raw problem instances in dir under a grid of "
+               "settings using\n"
+               "\tthreads threads (default: all cores), ranks the settings "
+               "by median and\n"
+               "\tp95 solve time and writes the best to profile (default: "
+               "stdout)\n",
+               argv[0]);
+        return -1;
+    }
+    numThreads = argc > 2 ? atoi(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+    numThreads = numThreads > 0 ? numThreads : 1;
+
+    t.numInst = loadInstances(argv[1], &t.inst);
+    if (t.numInst <= 0) {
+        printf("no instances in %s\n", argv[1]);
+        return -1;
+    }
+    t.cfg = cfg;
+    t.numCfg = makeConfigs(cfg);
+    t.time = scs_malloc(t.numCfg * t.numInst * sizeof(scs_float));
+    t.accurate = scs_malloc(t.numCfg * t.numInst * sizeof(scs_int));
+    t.next = 0;
+    pthread_mutex_init(&t.lock, SCS_NULL);
+    printf("tuning over %li instances, %li settings, %li threads\n",
+           (long)t.numInst, (long)t.numCfg, (long)numThreads);
+
+    threads = scs_malloc(numThreads * sizeof(pthread_t));
+    for (i = 0; i < numThreads; ++i) {
+        pthread_create(&threads[i], SCS_NULL, worker, &t);
+    }
+    for (i = 0; i < numThreads; ++i) {
+        pthread_join(threads[i], SCS_NULL);
+    }
+    pthread_mutex_destroy(&t.lock);
+
+    times = scs_malloc(t.numInst * sizeof(scs_float));
+    for (i = 0; i < t.numCfg; ++i) {
+        c = &cfg[i];
+        c->numAccurate = 0;
+        for (j = 0; j < t.numInst; ++j) {
+            c->numAccurate += t.accurate[i * t.numInst + j];
+            times[j] = t.time[i * t.numInst + j];
+        }
+        qsort(times, t.numInst, sizeof(scs_float), cmpFloat);
+        c->median = times[(t.numInst - 1) / 2];
+        c->p95 = times[(scs_int)ceil(0.95 * t.numInst) - 1];
+        if (c->normalize == NORMALIZE && c->scale == SCALE &&
+            c->rho_x == RHO_X && c->alpha == ALPHA && c->cg_rate == CG_RATE) {
+            defaults = i;
+        }
+    }
+    if (defaults >= 0) {
+        printf("defaults: accurate %li/%li, median %.3gms, p95 %.3gms\n",
+               (long)cfg[defaults].numAccurate, (long)t.numInst,
+               cfg[defaults].median, cfg[defaults].p95);
+    }
+    qsort(cfg, t.numCfg, sizeof(Config), cmpConfig);
+    printf("rank normalize    scale    rho_x  alpha cg_rate  accurate  "
+           "median ms     p95 ms\n");
+    for (i = 0; i < MIN(t.numCfg, 10); ++i) {
+        c = &cfg[i];
+        printf("%4li %9li %8.2g %8.2g %6.2f %7.2f %5li/%-4li %10.3g %10.3g\n",
+               (long)i + 1, (long)c->normalize, c->scale, c->rho_x, c->alpha,
+               c->cg_rate, (long)c->numAccurate, (long)t.numInst, c->median,
+               c->p95);
+    }
+
+    fp = argc > 3 ? fopen(argv[3], "w") : stdout;
+    if (!fp) {
+        printf("couldn't open %s\n", argv[3]);
+        return -1;
+    }
+    writeProfile(fp, &cfg[0], t.numInst);
+    if (fp != stdout) {
+        fclose(fp);
+        printf("wrote profile to %s\n", argv[3]);
+    }
+
+    for (i = 0; i < t.numInst; ++i) {
+        freeData(t.inst[i].d, t.inst[i].k);
+        free(t.inst[i].name);
+    }
+    scs_free(t.inst);
+    scs_free(times);
+    scs_free(threads);
+    scs_free(t.time);
+    scs_free(t.accurate);
+    return 0;
+}
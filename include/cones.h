@@ -12,8 +12,13 @@ extern "C" {
 struct SCS_CONE {
     scs_int f;     /* number of linear equality constraints */
     scs_int l;     /* length of LP cone */
+    scs_int bsize; /* length of box cone, including the scale variable t */
+    scs_float *bl; /* box cone lower bounds, length bsize - 1 */
+    scs_float *bu; /* box cone upper bounds, length bsize - 1 */
     scs_int *q;    /* array of second-order cone constraints */
     scs_int qsize; /* length of SOC array */
+    scs_int *r;    /* array of rotated second-order cone constraints */
+    scs_int rsize; /* length of rotated SOC array */
     scs_int *s;    /* array of SD constraints */
     scs_int ssize; /* length of SD array */
     scs_int ep;    /* number of primal exponential cone triples */
@@ -24,15 +29,40 @@ struct SCS_CONE {
     scs_int psize; /* number of (primal and dual) power cone triples */
 };
 
+typedef struct CONE_WORK ConeWork;
+typedef struct CONE_BLOCK ConeBlock;
+
+/* projects the cones of block b, x points to the first row of the block */
+typedef scs_int (*coneProjFn)(scs_float *x, const ConeBlock *b, ConeWork *c,
+                              scs_int iter);
+
+/* one step of the projection plan: num consecutive cones of the same type and
+ * size starting at row offset */
+struct CONE_BLOCK {
+    coneProjFn proj;        /* projection kernel for this cone type */
+    scs_int offset;         /* first row of the block */
+    scs_int size;           /* rows per cone */
+    scs_int num;            /* number of cones in the block */
+    scs_int dim;            /* matrix dimension, SD cones only */
+    const scs_float *param; /* per-cone parameters, power cones only */
+    const char *name;       /* cone type, for reporting */
+};
+
 /* private data to help cone projection step */
-typedef struct {
+struct CONE_WORK {
 #ifdef LAPACK_LIB_FOUND
     /* workspace for eigenvector decompositions: */
     scs_float *Xs, *Z, *e, *work;
     blasint *iwork, lwork, liwork;
 #endif
+    /* projection plan compiled by initCone, projDualCone runs it in order */
+    ConeBlock *plan;
+    scs_int planLen;
+    scs_float *powParams; /* copy of the power cone parameters */
+    scs_float *bl, *bu;   /* copy of the box cone bounds */
+    scs_float *boxWork;   /* workspace for the box cone projection */
     scs_float totalConeTime;
-} ConeWork;
+};
 
 /*
  * boundaries will contain array of indices of rows of A corresponding to
@@ -43,6 +73,13 @@ typedef struct {
  */
 scs_int getConeBoundaries(const Cone *k, scs_int **boundaries);
 
+/* cone signatures that have specialized projection kernels in scs_solve */
+#define CONE_SIG_GENERIC (0) /* any cone, projected with projDualCone */
+#define CONE_SIG_LP (1)      /* zero and linear cones only */
+#define CONE_SIG_LP_SOC (2)  /* zero, linear and (rotated) second-order cones
+                                only */
+scs_int getConeSignature(const Cone *k);
+
 ConeWork *initCone(const Cone *k);
 char *getConeHeader(const Cone *k);
 scs_int validateCones(const Data *d, const Cone *k);
@@ -52,6 +89,9 @@ scs_int validateCones(const Data *d, const Cone *k);
  of solution, can be SCS_NULL*/
 scs_int projDualCone(scs_float *x, const Cone *k, ConeWork *c,
                      const scs_float *warm_start, scs_int iter);
+/* projects only the (rotated) second-order cones in the plan, no timing, for
+ * use by the specialized CONE_SIG_LP_SOC path */
+void projSocCones(scs_float *x, ConeWork *c);
 void finishCone(ConeWork *coneWork);
 char *getConeSummary(const Info *info, ConeWork *c);
 
@@ -21,6 +21,13 @@ extern "C" {
 #define SCS_SOLVED (1)
 #define SCS_SOLVED_INACCURATE (2)
 
+/* linear system backends, the linsys setting:                          */
+#define LINSYS_AUTO (0) /* predicted fastest of those linked */
+#define LINSYS_DIRECT (1)
+#define LINSYS_INDIRECT (2)
+#define LINSYS_GPU (3)
+#define LINSYS_DENSE (4) /* needs blas and lapack */
+
 /* DEFAULT SOLVER PARAMETERS AND SETTINGS --------------------------    */
 #define MAX_ITERS (2500)
 #define EPS (1E-3)
@@ -31,6 +38,11 @@ extern "C" {
 #define VERBOSE (1)
 #define NORMALIZE (1)
 #define WARM_START (0)
+#define POLISH (0)
+#define ADAPT_SCALE (0)
+#define ADAPT_ALPHA (0)
+#define STALL_STOP (0)
+#define LINSYS (LINSYS_AUTO)
 
 #ifdef __cplusplus
 }
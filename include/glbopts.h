@@ -12,8 +12,12 @@ extern "C" {
 #include "mex.h"
 #define scs_printf mexPrintf
 #define _scs_free mxFree
-#define _scs_malloc mxMalloc
-#define _scs_calloc mxCalloc
+#define _scs_malloc scsMexMalloc
+#define _scs_calloc scsMexCalloc
+/* mxMalloc and mxCalloc, made persistent while scs_mex.c sets up or solves a
+ * workspace kept between calls */
+void *scsMexMalloc(size_t size);
+void *scsMexCalloc(size_t num, size_t size);
 #elif defined PYTHON
 #include <Python.h>
 #include <stdlib.h>
@@ -6,7 +6,7 @@ extern "C" {
 #endif
 
 /* YOUR LINEAR SYSTEM SOLVER MUST IMPLEMENT THESE METHODS AND PRIVATE_DATA
- * STRUCT */
+ * STRUCT, AND EXPORT THEM AS A LinSys BACKEND */
 
 /* private data structs (that you define) containing any necessary data to solve
  * linear system, etc. */
@@ -17,39 +17,76 @@ typedef struct A_DATA_MATRIX AMatrix;
  * interacts with this struct */
 typedef struct PRIVATE_DATA Priv;
 
-/* initialize Priv structure and perform any necessary preprocessing */
-Priv *initPriv(const AMatrix *A, const Settings *stgs);
-/* solves [d->RHO_X * I  A' ; A  -I] x = b for x, stores result in b, s contains
- * warm-start, iter is current scs iteration count */
-scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
-                    scs_float *b, const scs_float *s, scs_int iter);
-/* frees Priv structure and allocated memory in Priv */
-void freePriv(Priv *p);
+/* a linear system backend, several can be linked into one library and each
+ * Work uses the one selectLinSys picks */
+typedef struct LINSYS_BACKEND {
+    scs_int id; /* LINSYS_DIRECT etc., constants.h */
+    /* initialize Priv structure and perform any necessary preprocessing */
+    Priv *(*initPriv)(const AMatrix *A, const Settings *stgs);
+    /* solves [d->RHO_X * I  A' ; A  -I] x = b for x, stores result in b, s
+     * contains warm-start, iter is current scs iteration count; the residual
+     * check relies on the second block row, ie A * x[0:n] = x[n:n+m] +
+     * b[n:n+m] on output, so it must hold to working precision even for
+     * inexact solvers */
+    scs_int (*solveLinSys)(const AMatrix *A, const Settings *stgs, Priv *p,
+                           scs_float *b, const scs_float *s, scs_int iter);
+    /* updates Priv after the values of A or stgs->rho_x changed, the sparsity
+     * pattern of A is the one given to initPriv; returns negative on failure */
+    scs_int (*updateLinSys)(const AMatrix *A, const Settings *stgs, Priv *p);
+    /* solves the polishing system [0 A_a'; A_a 0] x = b, where A_a is A
+     * restricted to the rows with active[i] != 0 and the inactive rows of
+     * x[n:n+m] are zero, x holds a guess on input and the solution on output,
+     * which stays near the guess if the system is singular; returns negative
+     * if it fails or if the solver does not support polishing */
+    scs_int (*solvePolishSys)(const AMatrix *A, const Settings *stgs, Priv *p,
+                              const scs_int *active, const scs_float *b,
+                              scs_float *x);
+    /* frees Priv structure and allocated memory in Priv */
+    void (*freePriv)(Priv *p);
+    /* forms y += A'*x */
+    void (*accumByAtrans)(const AMatrix *A, Priv *p, const scs_float *x,
+                          scs_float *y);
+    /* forms y += A*x */
+    void (*accumByA)(const AMatrix *A, Priv *p, const scs_float *x,
+                     scs_float *y);
+    /* returns string describing method, can return null, if not null free
+     * will be called on output */
+    char *(*getLinSysMethod)(const AMatrix *A, const Settings *stgs);
+    /* returns string containing summary information about linear system
+     * solves, can return null, if not null free will be called on output */
+    char *(*getLinSysSummary)(Priv *p, const Info *info);
+    /* predicted flops of the setup and of iters solves, from the sparsity of
+     * A only, used to pick a backend; negative if it cannot tell */
+    scs_float (*estimateCost)(const AMatrix *A, const Settings *stgs,
+                              scs_int iters);
+} LinSys;
 
-/* forms y += A'*x */
-void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x, scs_float *y);
-/* forms y += A*x */
-void accumByA(const AMatrix *A, Priv *p, const scs_float *x, scs_float *y);
+/* the backends, each defined in linsys/<name>/private.c */
+extern const LinSys directLinSys;
+extern const LinSys indirectLinSys;
+extern const LinSys gpuLinSys;
+extern const LinSys denseLinSys;
+
+/* returns the backend of stgs->linsys, for LINSYS_AUTO the one predicted to
+ * be fastest on A among those linked, SCS_NULL if it is not linked; a library
+ * with one backend gets this from the backend, one with several (built with
+ * ALL_LINSYS) from linsys/all/private.c */
+const LinSys *selectLinSys(const AMatrix *A, const Settings *stgs);
 
 /* returns negative num if input data is invalid */
 scs_int validateLinSys(const AMatrix *A);
 
-/* returns string describing method, can return null, if not null free will be
- * called on output */
-char *getLinSysMethod(const AMatrix *A, const Settings *stgs);
-/* returns string containing summary information about linear system solves, can
- * return null, if not null free will be called on output */
-char *getLinSysSummary(Priv *p, const Info *info);
-
 /* Normalization routines, used if d->NORMALIZE is true */
 /* normalizes A matrix, sets w->E and w->D diagonal scaling matrices, Anew =
  * d->SCALE * (D^-1)*A*(E^-1) (different to paper which is D*A*E)
  * D and E must be all positive entries, D must satisfy cone boundaries
  * must set (w->meanNormRowA = mean of norms of rows of normalized A) THEN scale
  * resulting A by d->SCALE */
-void normalizeA(AMatrix *A, const Settings *stgs, const Cone *k, Scaling *scal);
+void normalizeA(AMatrix *A, scs_float scale, const Cone *k, Scaling *scal);
 /* unnormalizes A matrix, unnormalizes by w->D and w->E and d->SCALE */
-void unNormalizeA(AMatrix *A, const Settings *stgs, const Scaling *scal);
+void unNormalizeA(AMatrix *A, scs_float scale, const Scaling *scal);
+/* multiplies A by f, used when the scale changes after normalization */
+void scaleAMatrix(AMatrix *A, scs_float f);
 /* to free the memory allocated in AMatrix */
 void freeAMatrix(AMatrix *A);
 
@@ -57,6 +94,9 @@ void freeAMatrix(AMatrix *A);
 /* copies A (instead of in-place normalization), returns 0 for failure,
  * allocates memory for dstp	*/
 scs_int copyAMatrix(AMatrix **dstp, const AMatrix *src);
+/* copies the values of src into dst, a copy of a matrix with the same
+ * pattern, returns -1 if the dimensions or number of entries differ */
+scs_int copyAMatrixValues(AMatrix *dst, const AMatrix *src);
 #endif
 
 #ifdef __cplusplus
@@ -38,12 +38,24 @@ struct SCS_SETTINGS {
     /* these can change for multiple runs with the same call to scs_init */
     scs_int max_iters;  /* maximum iterations to take: 2500 */
     scs_float eps;      /* convergence tolerance: 1e-3 */
-    scs_float alpha;    /* relaxation parameter: 1.8 */
+    scs_float alpha;    /* relaxation parameter: 1.5 */
     scs_float cg_rate;  /* for indirect, tolerance goes down like
                            (1/iter)^cg_rate: 2 */
     scs_int verbose;    /* boolean, write out progress: 1 */
     scs_int warm_start; /* boolean, warm start (put initial guess in Sol
                            struct): 0 */
+    scs_int polish;     /* boolean, polish the solution after convergence,
+                           direct solver only: 0 */
+    scs_int adapt_scale; /* if normalized, max number of updates of scale
+                            from the residual balance per solve, each one
+                            refactors the linear system, 0 disables: 0 */
+    scs_int adapt_alpha; /* boolean, adapt alpha from the contraction of the
+                            fixed point residual, starting at alpha: 0 */
+    scs_int stall_stop; /* boolean, stop as inaccurate when the residuals
+                           stop improving: 0 */
+    scs_int linsys; /* linear system backend, picked at scs_init: one of
+                       LINSYS_AUTO, LINSYS_DIRECT, LINSYS_INDIRECT,
+                       LINSYS_GPU or LINSYS_DENSE, constants.h: LINSYS_AUTO */
 };
 
 /* contains primal-dual solution arrays */
@@ -65,6 +77,7 @@ struct SCS_INFO {
     scs_float relGap;    /* relative duality gap */
     scs_float setupTime; /* time taken for setup phase (milliseconds) */
     scs_float solveTime; /* time taken for solve phase (milliseconds) */
+    scs_float alpha;     /* relaxation parameter at the end of the solve */
 };
 
 /* contains normalization variables */
@@ -83,12 +96,32 @@ struct SCS_SCALING {
 Work *scs_init(const Data *d, const Cone *k, Info *info);
 scs_int scs_solve(Work *w, const Data *d, const Cone *k, Sol *sol, Info *info);
 void scs_finish(Work *w);
+/* scs_update_A takes new values for A, with the pattern (and rank) it had at
+ * scs_init, from d->A, where they must all be written over the old ones if A
+ * is not copied (COPYAMATRIX) and normalize is set, since A is normalized in
+ * place then; A is normalized again and the linear system refactored
+ * numerically, the ordering is kept; returns negative on failure */
+scs_int scs_update_A(Work *w, const Data *d, const Cone *k);
 /* scs calls scs_init, scs_solve, and scs_finish */
 scs_int scs(const Data *d, const Cone *k, Sol *sol, Info *info);
 const char *scs_version(void);
+#if RACE > 0
+/* scs_race solves the problem under each of the num settings in stgs (in place
+ * of d->stgs) concurrently, one thread each, all sharing A. The first to
+ * converge (solved, infeasible or unbounded) cancels the others, else the
+ * first to finish is kept. Its result goes in sol and info, and its index in
+ * stgs is returned, -1 on bad input. */
+scs_int scs_race(const Data *d, const Cone *k, const Settings *stgs,
+                 scs_int num, Sol *sol, Info *info);
+#endif
 
 /* the following structs are not exposed to user */
 
+#if ASYNC_RESID > 0
+/* residual checks on a helper thread, defined in scs.c */
+typedef struct ASYNC_RESID_WORK AsyncResid;
+#endif
+
 /* workspace for SCS */
 struct SCS_WORK {
     scs_float *u, *v, *u_t, *u_prev; /* u_prev = u from previous iteration */
@@ -97,10 +130,33 @@ struct SCS_WORK {
     scs_float *b, *c;   /* (possibly normalized) b and c vectors */
     scs_int m, n;       /* A has m rows, n cols */
     AMatrix *A;         /* (possibly normalized) A matrix */
+    const LinSys *linsys; /* linear system backend */
     Priv *p;            /* struct populated by linear system solver */
     Settings *stgs;     /* contains solver settings specified by user */
     Scaling *scal;      /* contains the re-scaling data */
     ConeWork *coneWork; /* workspace for the cone projection step */
+    scs_int coneSig;    /* cone signature, selects the projection kernel */
+    scs_int AxIter;     /* iteration whose A * x is held in pr, -1 if none */
+    /* adaptive convergence check schedule */
+    scs_int nextCheck, lastCheck;
+    scs_float lastProgress;
+    /* stall detection over doubling windows of iterations */
+    scs_int stallEnd, stalled;
+    scs_float stallRef, stallBest, stallRefFpr, stallBestFpr;
+    /* adaptive scale: updates so far in this solve, the last one, and the
+     * log residual ratios seen since */
+    scs_int rescales, lastRescale, logRatioCount;
+    scs_float logRatioSum;
+    scs_float scale; /* scale in use, starts at stgs->scale */
+    /* relaxation parameter in use, and the adaptive alpha search: direction,
+     * start of the current window with its fpr, rate of the last window */
+    scs_float alpha, alphaFpr, alphaRate;
+    scs_int alphaDir, alphaIter;
+    scs_int *cancel; /* stops the solve once set by another thread, read
+                        atomically, SCS_NULL if none */
+#if ASYNC_RESID > 0
+    AsyncResid *async; /* helper thread for the residuals, SCS_NULL if none */
+#endif
 };
 
 /* to hold residual information (unnormalized) */
@@ -115,6 +171,7 @@ struct residuals {
     scs_float bTy_by_tau; /* not divided by tau */
     scs_float tau;
     scs_float kap;
+    scs_float fpr; /* |u - u_prev| / |u|, set by the main loop */
 };
 
 #ifdef __cplusplus
@@ -56,6 +56,11 @@ void printData(const Data *d);
 void printWork(const Work *w);
 void printArray(const scs_float *arr, scs_int n, const char *name);
 void setDefaultSettings(Data *d);
+/* reads a settings profile, as written by the tuner, into stgs: lines of
+ * "name value" with the Settings field names, '#' starts a comment line, the
+ * fields not in the file are left as they are; returns negative if the file
+ * cannot be read or names an unknown field */
+scs_int readSettings(Settings *stgs, const char *filename);
 void freeSol(Sol *sol);
 void freeData(Data *d, Cone *k);
 
@@ -15,6 +15,38 @@ extern "C" {
 JNIEXPORT void JNICALL Java_org_scs_IndirectSolver_csolve
   (JNIEnv *, jclass, jobject, jdoubleArray, jdoubleArray, jobject, jobject, jobject, jobject);
 
+/*
+ * Class:     org_scs_IndirectSolver
+ * Method:    csolveBuffers
+ * Signature: (Lorg/scs/BufferData;Lorg/scs/Cone;Lorg/scs/Settings;Lorg/scs/BufferSolution;Lorg/scs/Info;)V
+ */
+JNIEXPORT void JNICALL Java_org_scs_IndirectSolver_csolveBuffers
+  (JNIEnv *, jclass, jobject, jobject, jobject, jobject, jobject);
+
+/*
+ * Class:     org_scs_IndirectSolver
+ * Method:    cinit
+ * Signature: (Lorg/scs/BufferData;Lorg/scs/Cone;Lorg/scs/Settings;Lorg/scs/Info;)J
+ */
+JNIEXPORT jlong JNICALL Java_org_scs_IndirectSolver_cinit
+  (JNIEnv *, jclass, jobject, jobject, jobject, jobject);
+
+/*
+ * Class:     org_scs_IndirectSolver
+ * Method:    csolveWork
+ * Signature: (JLorg/scs/BufferSolution;ZLorg/scs/Info;)V
+ */
+JNIEXPORT void JNICALL Java_org_scs_IndirectSolver_csolveWork
+  (JNIEnv *, jclass, jlong, jobject, jboolean, jobject);
+
+/*
+ * Class:     org_scs_IndirectSolver
+ * Method:    cfinish
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_scs_IndirectSolver_cfinish
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     org_scs_IndirectSolver
  * Method:    cversion
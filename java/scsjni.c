@@ -1,3 +1,4 @@
+#include <stdint.h>
 #include "glbopts.h"
 #include "scs.h"
 #include "cones.h"
@@ -9,35 +10,125 @@
 #include "org_scs_DirectSolver.h"
 #endif
 
-jobject getObjUsingGetter(JNIEnv * env, jobject obj, char * method, char * signature) {
-    // Get method ID for method getSomeArray that returns an array
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, signature);
+// the getters and setters called on the java objects, their method ids are
+// looked up once when the library is loaded rather than on every call
+enum {
+    SETTINGS_MAX_ITERS, SETTINGS_EPS, SETTINGS_ALPHA, SETTINGS_RHO_X,
+    SETTINGS_CG_RATE, SETTINGS_VERBOSE, SETTINGS_NORMALIZE, SETTINGS_SCALE,
+    SETTINGS_WARM_START, SETTINGS_POLISH, SETTINGS_ADAPT_SCALE,
+    SETTINGS_ADAPT_ALPHA, SETTINGS_STALL_STOP,
+    CONE_Q, CONE_S, CONE_L, CONE_F, CONE_EP, CONE_ED, CONE_P,
+    AMATRIX_ROW_IDXS, AMATRIX_COL_IDXS, AMATRIX_VALUES,
+    BUFFERDATA_NUM_ROWS, BUFFERDATA_NUM_COLS, BUFFERDATA_ROW_IDXS,
+    BUFFERDATA_COL_IDXS, BUFFERDATA_VALUES, BUFFERDATA_B, BUFFERDATA_C,
+    BUFFERSOLUTION_X, BUFFERSOLUTION_Y, BUFFERSOLUTION_S,
+    SOLUTION_X, SOLUTION_Y, SOLUTION_S,
+    INFO_ITER, INFO_STATUS_VAL, INFO_STATUS, INFO_POBJ, INFO_DOBJ,
+    INFO_RES_PRI, INFO_RES_DUAL, INFO_RES_INFEAS, INFO_RES_UNBDD,
+    INFO_REL_GAP, INFO_SETUP_TIME, INFO_SOLVE_TIME, INFO_ALPHA,
+    NUM_METHODS
+};
+
+typedef struct {
+    const char * clazz;
+    const char * name;
+    const char * signature;
+    jmethodID id;
+} Method;
+
+static Method methods[NUM_METHODS] = {
+    {"org/scs/Settings", "getMaxIters", "()I"},
+    {"org/scs/Settings", "getEps", "()D"},
+    {"org/scs/Settings", "getAlpha", "()D"},
+    {"org/scs/Settings", "getRhoX", "()D"},
+    {"org/scs/Settings", "getCgRate", "()D"},
+    {"org/scs/Settings", "isVerbose", "()Z"},
+    {"org/scs/Settings", "isNormalize", "()Z"},
+    {"org/scs/Settings", "getScale", "()D"},
+    {"org/scs/Settings", "isWarmStart", "()Z"},
+    {"org/scs/Settings", "isPolish", "()Z"},
+    {"org/scs/Settings", "getAdaptScale", "()I"},
+    {"org/scs/Settings", "isAdaptAlpha", "()Z"},
+    {"org/scs/Settings", "isStallStop", "()Z"},
+    {"org/scs/Cone", "getQ", "()[I"},
+    {"org/scs/Cone", "getS", "()[I"},
+    {"org/scs/Cone", "getL", "()I"},
+    {"org/scs/Cone", "getF", "()I"},
+    {"org/scs/Cone", "getEp", "()I"},
+    {"org/scs/Cone", "getEd", "()I"},
+    {"org/scs/Cone", "getP", "()[D"},
+    {"org/scs/AMatrix", "getRowIdxs", "()[I"},
+    {"org/scs/AMatrix", "getColIdxs", "()[I"},
+    {"org/scs/AMatrix", "getValues", "()[D"},
+    {"org/scs/BufferData", "getNumRows", "()I"},
+    {"org/scs/BufferData", "getNumCols", "()I"},
+    {"org/scs/BufferData", "getRowIdxs", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/BufferData", "getColIdxs", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/BufferData", "getValues", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/BufferData", "getB", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/BufferData", "getC", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/BufferSolution", "getX", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/BufferSolution", "getY", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/BufferSolution", "getS", "()Ljava/nio/ByteBuffer;"},
+    {"org/scs/Solution", "setX", "([D)V"},
+    {"org/scs/Solution", "setY", "([D)V"},
+    {"org/scs/Solution", "setS", "([D)V"},
+    {"org/scs/Info", "setIter", "(I)V"},
+    {"org/scs/Info", "setStatusVal", "(I)V"},
+    {"org/scs/Info", "setStatus", "(Ljava/lang/String;)V"},
+    {"org/scs/Info", "setPobj", "(D)V"},
+    {"org/scs/Info", "setDobj", "(D)V"},
+    {"org/scs/Info", "setResPri", "(D)V"},
+    {"org/scs/Info", "setResDual", "(D)V"},
+    {"org/scs/Info", "setResInfeas", "(D)V"},
+    {"org/scs/Info", "setResUnbdd", "(D)V"},
+    {"org/scs/Info", "setRelGap", "(D)V"},
+    {"org/scs/Info", "setSetupTime", "(D)V"},
+    {"org/scs/Info", "setSolveTime", "(D)V"},
+    {"org/scs/Info", "setAlpha", "(D)V"},
+};
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM * vm, void * reserved) {
+    JNIEnv * env;
+    jclass clazz;
+    int i;
+    if ((*vm)->GetEnv(vm, (void **) &env, JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+    for (i = 0; i < NUM_METHODS; i++) {
+        clazz = (*env)->FindClass(env, methods[i].clazz);
+        if (!clazz) {
+            return JNI_ERR;
+        }
+        methods[i].id = (*env)->GetMethodID(env, clazz, methods[i].name, methods[i].signature);
+        (*env)->DeleteLocalRef(env, clazz);
+        if (!methods[i].id) {
+            return JNI_ERR;
+        }
+    }
+    return JNI_VERSION_1_6;
+}
+
+jobject getObjUsingGetter(JNIEnv * env, jobject obj, int method) {
     // Call the method, returns JObject (because Array is instance of Object)
-    return (*env)->CallObjectMethod(env, obj, mid);
+    return (*env)->CallObjectMethod(env, obj, methods[method].id);
 }
 
-scs_int getIntUsingGetter(JNIEnv * env, jobject obj, char * method) {
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, "()I");
-    return (scs_int) (*env)->CallIntMethod(env, obj, mid);
+scs_int getIntUsingGetter(JNIEnv * env, jobject obj, int method) {
+    return (scs_int) (*env)->CallIntMethod(env, obj, methods[method].id);
 }
 
-scs_float getFloatUsingGetter(JNIEnv * env, jobject obj, char * method) {
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, "()D");
-    return (scs_float) (*env)->CallDoubleMethod(env, obj, mid);
+scs_float getFloatUsingGetter(JNIEnv * env, jobject obj, int method) {
+    return (scs_float) (*env)->CallDoubleMethod(env, obj, methods[method].id);
 }
 
-scs_int getBooleanUsingGetter(JNIEnv * env, jobject obj, char * method) {
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, "()Z");
-    return (scs_int) (*env)->CallBooleanMethod(env, obj, mid);
+scs_int getBooleanUsingGetter(JNIEnv * env, jobject obj, int method) {
+    return (scs_int) (*env)->CallBooleanMethod(env, obj, methods[method].id);
 }
 
-scs_int * getIntArrayUsingGetter(JNIEnv * env, jobject obj, char * method, scs_int * length) {
+scs_int * getIntArrayUsingGetter(JNIEnv * env, jobject obj, int method, scs_int * length) {
     scs_int * out;
-    jintArray arr = (jintArray) getObjUsingGetter(env, obj, method, "()[I");
+    jintArray arr = (jintArray) getObjUsingGetter(env, obj, method);
     if (!arr) {
         *length = 0;
         return SCS_NULL;
@@ -48,9 +139,9 @@ scs_int * getIntArrayUsingGetter(JNIEnv * env, jobject obj, char * method, scs_i
     return out;
 }
 
-scs_float * getFloatArrayUsingGetter(JNIEnv * env, jobject obj, char * method, scs_int * length) {
+scs_float * getFloatArrayUsingGetter(JNIEnv * env, jobject obj, int method, scs_int * length) {
     scs_float * out;
-    jdoubleArray arr = (jdoubleArray) getObjUsingGetter(env, obj, method, "()[D");
+    jdoubleArray arr = (jdoubleArray) getObjUsingGetter(env, obj, method);
     if (!arr) {
         *length = 0;
         return SCS_NULL;
@@ -61,15 +152,30 @@ scs_float * getFloatArrayUsingGetter(JNIEnv * env, jobject obj, char * method, s
     return out;
 }
 
+// the address of the direct buffer returned by the getter, read and written
+// in place; null if it is not a direct buffer
+void * getBufferUsingGetter(JNIEnv * env, jobject obj, int method) {
+    jobject buf = getObjUsingGetter(env, obj, method);
+    return buf ? (*env)->GetDirectBufferAddress(env, buf) : SCS_NULL;
+}
+
+int throwIllegalArgument(JNIEnv * env, const char * msg) {
+    jclass clazz = (*env)->FindClass(env, "java/lang/IllegalArgumentException");
+    if (clazz) {
+        (*env)->ThrowNew(env, clazz, msg);
+    }
+    return -1;
+}
+
 Cone * getConeStruct(JNIEnv * env, jobject coneJava) {
     Cone * k = scs_calloc(1, sizeof(Cone));
-    k->q = getIntArrayUsingGetter(env, coneJava, "getQ", &(k->qsize));
-    k->s = getIntArrayUsingGetter(env, coneJava, "getS", &(k->ssize));
-    k->l = getIntUsingGetter(env, coneJava, "getL");
-    k->f = getIntUsingGetter(env, coneJava, "getF");
-    k->ep = getIntUsingGetter(env, coneJava, "getEp");
-    k->ed = getIntUsingGetter(env, coneJava, "getEd");
-    k->p = getFloatArrayUsingGetter(env, coneJava, "getP", &(k->psize));
+    k->q = getIntArrayUsingGetter(env, coneJava, CONE_Q, &(k->qsize));
+    k->s = getIntArrayUsingGetter(env, coneJava, CONE_S, &(k->ssize));
+    k->l = getIntUsingGetter(env, coneJava, CONE_L);
+    k->f = getIntUsingGetter(env, coneJava, CONE_F);
+    k->ep = getIntUsingGetter(env, coneJava, CONE_EP);
+    k->ed = getIntUsingGetter(env, coneJava, CONE_ED);
+    k->p = getFloatArrayUsingGetter(env, coneJava, CONE_P, &(k->psize));
     return k;
 }
 
@@ -77,9 +183,9 @@ AMatrix * getAMatrix(JNIEnv *env, jobject AJava, scs_int m, scs_int n) {
     scs_int leni, lenp, lenx;
     AMatrix * A = scs_calloc(1, sizeof(AMatrix));
     // populate A
-    A->i = getIntArrayUsingGetter(env, AJava, "getRowIdxs", &leni);
-    A->p = getIntArrayUsingGetter(env, AJava, "getColIdxs", &lenp);
-    A->x = getFloatArrayUsingGetter(env, AJava, "getValues", &lenx);
+    A->i = getIntArrayUsingGetter(env, AJava, AMATRIX_ROW_IDXS, &leni);
+    A->p = getIntArrayUsingGetter(env, AJava, AMATRIX_COL_IDXS, &lenp);
+    A->x = getFloatArrayUsingGetter(env, AJava, AMATRIX_VALUES, &lenx);
     A->m = m;
     A->n = n;
     return A;
@@ -87,75 +193,131 @@ AMatrix * getAMatrix(JNIEnv *env, jobject AJava, scs_int m, scs_int n) {
 
 void populateParams(JNIEnv * env, jobject paramsJava, Data * d) {
     d->stgs = scs_malloc(sizeof(Settings));
-    d->stgs->max_iters = getIntUsingGetter(env, paramsJava, "getMaxIters");
-    d->stgs->eps = getFloatUsingGetter(env, paramsJava, "getEps");
-    d->stgs->alpha = getFloatUsingGetter(env, paramsJava, "getAlpha");
-    d->stgs->rho_x = getFloatUsingGetter(env, paramsJava, "getRhoX");
-    d->stgs->cg_rate = getFloatUsingGetter(env, paramsJava, "getCgRate");
-    d->stgs->verbose = getBooleanUsingGetter(env, paramsJava, "isVerbose");
-    d->stgs->normalize = getBooleanUsingGetter(env, paramsJava, "isNormalize");
-    d->stgs->scale = getFloatUsingGetter(env, paramsJava, "getScale");
-    d->stgs->warm_start = getBooleanUsingGetter(env, paramsJava, "isWarmStart");
+    d->stgs->max_iters = getIntUsingGetter(env, paramsJava, SETTINGS_MAX_ITERS);
+    d->stgs->eps = getFloatUsingGetter(env, paramsJava, SETTINGS_EPS);
+    d->stgs->alpha = getFloatUsingGetter(env, paramsJava, SETTINGS_ALPHA);
+    d->stgs->rho_x = getFloatUsingGetter(env, paramsJava, SETTINGS_RHO_X);
+    d->stgs->cg_rate = getFloatUsingGetter(env, paramsJava, SETTINGS_CG_RATE);
+    d->stgs->verbose = getBooleanUsingGetter(env, paramsJava, SETTINGS_VERBOSE);
+    d->stgs->normalize = getBooleanUsingGetter(env, paramsJava, SETTINGS_NORMALIZE);
+    d->stgs->scale = getFloatUsingGetter(env, paramsJava, SETTINGS_SCALE);
+    d->stgs->warm_start = getBooleanUsingGetter(env, paramsJava, SETTINGS_WARM_START);
+    d->stgs->polish = getBooleanUsingGetter(env, paramsJava, SETTINGS_POLISH);
+    d->stgs->adapt_scale = getIntUsingGetter(env, paramsJava, SETTINGS_ADAPT_SCALE);
+    d->stgs->adapt_alpha = getBooleanUsingGetter(env, paramsJava, SETTINGS_ADAPT_ALPHA);
+    d->stgs->stall_stop = getBooleanUsingGetter(env, paramsJava, SETTINGS_STALL_STOP);
+    d->stgs->linsys = LINSYS; /* the one backend each library is built with */
 }
 
 Data * getDataStruct(JNIEnv * env, jobject AJava, jdoubleArray bJava, jdoubleArray cJava, jobject paramsJava) {
     Data * d = scs_calloc(1, sizeof(Data));
-    d->b = (*env)->GetDoubleArrayElements(env, bJava, SCS_NULL);
     d->m = (*env)->GetArrayLength(env, bJava);
-    d->c = (*env)->GetDoubleArrayElements(env, cJava, SCS_NULL);
+    d->b = scs_malloc(sizeof(scs_float) * d->m);
+    (*env)->GetDoubleArrayRegion(env, bJava, 0, d->m, d->b);
     d->n = (*env)->GetArrayLength(env, cJava);
+    d->c = scs_malloc(sizeof(scs_float) * d->n);
+    (*env)->GetDoubleArrayRegion(env, cJava, 0, d->n, d->c);
     d->A = getAMatrix(env, AJava, d->m, d->n);
     populateParams(env, paramsJava, d);
     return d;
 }
 
-void setFloatArrayUsingSetter(JNIEnv * env, jobject obj, scs_float * arr, scs_int length, char * method) {
+// frees a Data of getBufferDataStruct, not the buffers it points into
+void freeBufferDataStruct(Data * d) {
+    scs_free(d->A);
+    scs_free(d->stgs);
+    scs_free(d);
+}
+
+// Data with A, b and c pointing into the direct buffers of dJava (checked
+// for size by BufferData), which the solver reads in place; null with an
+// exception pending if a buffer is not direct
+Data * getBufferDataStruct(JNIEnv * env, jobject dJava, jobject paramsJava) {
+    Data * d;
+    AMatrix * A;
+    if (sizeof(scs_int) != sizeof(jint) || sizeof(scs_float) != sizeof(jdouble)) {
+        throwIllegalArgument(env, "buffers need scs built with DLONG = 0 and double floats");
+        return SCS_NULL;
+    }
+    d = scs_calloc(1, sizeof(Data));
+    A = scs_calloc(1, sizeof(AMatrix));
+    d->A = A;
+    d->m = A->m = getIntUsingGetter(env, dJava, BUFFERDATA_NUM_ROWS);
+    d->n = A->n = getIntUsingGetter(env, dJava, BUFFERDATA_NUM_COLS);
+    A->i = getBufferUsingGetter(env, dJava, BUFFERDATA_ROW_IDXS);
+    A->p = getBufferUsingGetter(env, dJava, BUFFERDATA_COL_IDXS);
+    A->x = getBufferUsingGetter(env, dJava, BUFFERDATA_VALUES);
+    d->b = getBufferUsingGetter(env, dJava, BUFFERDATA_B);
+    d->c = getBufferUsingGetter(env, dJava, BUFFERDATA_C);
+    populateParams(env, paramsJava, d);
+    if (!A->i || !A->p || !A->x || !d->b || !d->c) {
+        freeBufferDataStruct(d);
+        throwIllegalArgument(env, "A, b and c must be direct buffers");
+        return SCS_NULL;
+    }
+    return d;
+}
+
+// points sol into the direct buffers of solJava (checked for size by the
+// java caller); returns -1 with an exception pending if one is not direct
+int getBufferSol(JNIEnv * env, jobject solJava, Sol * sol) {
+    sol->x = getBufferUsingGetter(env, solJava, BUFFERSOLUTION_X);
+    sol->y = getBufferUsingGetter(env, solJava, BUFFERSOLUTION_Y);
+    sol->s = getBufferUsingGetter(env, solJava, BUFFERSOLUTION_S);
+    if (!sol->x || !sol->y || !sol->s) {
+        return throwIllegalArgument(env, "x, y and s must be direct buffers");
+    }
+    return 0;
+}
+
+void setFloatArrayUsingSetter(JNIEnv * env, jobject obj, scs_float * arr, scs_int length, int method) {
     jdoubleArray out = (*env)->NewDoubleArray(env, length);
     (*env)->SetDoubleArrayRegion(env, out, 0, length, arr);
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, "([D)V");
-    (*env)->CallVoidMethod(env, obj, mid, out);
+    (*env)->CallVoidMethod(env, obj, methods[method].id, out);
 }
 
-void setStringUsingSetter(JNIEnv * env, jobject obj, char * str, char * method) {
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, "(Ljava/lang/String;)V");
-    (*env)->CallVoidMethod(env, obj, mid, (*env)->NewStringUTF(env, str));
+void setStringUsingSetter(JNIEnv * env, jobject obj, char * str, int method) {
+    (*env)->CallVoidMethod(env, obj, methods[method].id, (*env)->NewStringUTF(env, str));
 }
 
-void setIntUsingSetter(JNIEnv * env, jobject obj, scs_int i, char * method) {
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, "(I)V");
-    (*env)->CallVoidMethod(env, obj, mid, i);
+void setIntUsingSetter(JNIEnv * env, jobject obj, scs_int i, int method) {
+    (*env)->CallVoidMethod(env, obj, methods[method].id, (jint) i);
 }
 
-void setFloatUsingSetter(JNIEnv * env, jobject obj, scs_float f, char * method) {
-    jclass clazz = (*env)->GetObjectClass(env, obj);
-    jmethodID mid = (*env)->GetMethodID(env, clazz, method, "(D)V");
-    (*env)->CallVoidMethod(env, obj, mid, f);
+void setFloatUsingSetter(JNIEnv * env, jobject obj, scs_float f, int method) {
+    (*env)->CallVoidMethod(env, obj, methods[method].id, (jdouble) f);
 }
 
 void setSol(JNIEnv * env, jobject solJava, Data * d, Sol * sol) {
-    setFloatArrayUsingSetter(env, solJava, sol->x, d->n, "setX");
-    setFloatArrayUsingSetter(env, solJava, sol->y, d->m, "setY");
-    setFloatArrayUsingSetter(env, solJava, sol->s, d->m, "setS");
+    setFloatArrayUsingSetter(env, solJava, sol->x, d->n, SOLUTION_X);
+    setFloatArrayUsingSetter(env, solJava, sol->y, d->m, SOLUTION_Y);
+    setFloatArrayUsingSetter(env, solJava, sol->s, d->m, SOLUTION_S);
 }
 
 void setInfo(JNIEnv * env, jobject infoJava, Info * info) {
-    setIntUsingSetter(env, infoJava, info->iter, "setIter");
-    setIntUsingSetter(env, infoJava, info->statusVal, "setStatusVal");
-    setStringUsingSetter(env, infoJava, info->status, "setStatus");
-    setFloatUsingSetter(env, infoJava, info->pobj, "setPobj");
-    setFloatUsingSetter(env, infoJava, info->dobj, "setDobj");
-    setFloatUsingSetter(env, infoJava, info->resPri, "setResPri");
-    setFloatUsingSetter(env, infoJava, info->resDual, "setResDual");
-    setFloatUsingSetter(env, infoJava, info->resInfeas, "setResInfeas");
-    setFloatUsingSetter(env, infoJava, info->resUnbdd, "setResUnbdd");
-    setFloatUsingSetter(env, infoJava, info->relGap, "setRelGap");
-    setFloatUsingSetter(env, infoJava, info->setupTime, "setSetupTime");
-    setFloatUsingSetter(env, infoJava, info->solveTime, "setSolveTime");
+    setIntUsingSetter(env, infoJava, info->iter, INFO_ITER);
+    setIntUsingSetter(env, infoJava, info->statusVal, INFO_STATUS_VAL);
+    setStringUsingSetter(env, infoJava, info->status, INFO_STATUS);
+    setFloatUsingSetter(env, infoJava, info->pobj, INFO_POBJ);
+    setFloatUsingSetter(env, infoJava, info->dobj, INFO_DOBJ);
+    setFloatUsingSetter(env, infoJava, info->resPri, INFO_RES_PRI);
+    setFloatUsingSetter(env, infoJava, info->resDual, INFO_RES_DUAL);
+    setFloatUsingSetter(env, infoJava, info->resInfeas, INFO_RES_INFEAS);
+    setFloatUsingSetter(env, infoJava, info->resUnbdd, INFO_RES_UNBDD);
+    setFloatUsingSetter(env, infoJava, info->relGap, INFO_REL_GAP);
+    setFloatUsingSetter(env, infoJava, info->setupTime, INFO_SETUP_TIME);
+    setFloatUsingSetter(env, infoJava, info->solveTime, INFO_SOLVE_TIME);
+    setFloatUsingSetter(env, infoJava, info->alpha, INFO_ALPHA);
 }
 
+// a persistent solver handle, the workspace of scs_init and its data
+typedef struct {
+    Data * d;
+    Cone * k;
+    Work * w;
+    scs_float setupTime; /* of scs_init, ms */
+} JavaWork;
+
 #ifdef INDIRECTJ
 JNIEXPORT jstring JNICALL Java_org_scs_IndirectSolver_cversion(JNIEnv *env, jclass clazz)
 #else
@@ -190,3 +352,94 @@ JNIEXPORT void JNICALL Java_org_scs_DirectSolver_csolve(JNIEnv *env, jclass claz
     scs_free(info);
 }
 
+#ifdef INDIRECTJ
+JNIEXPORT void JNICALL Java_org_scs_IndirectSolver_csolveBuffers(JNIEnv *env, jclass clazz, jobject dJava,
+        jobject coneJava, jobject paramsJava, jobject solJava, jobject infoJava)
+#else
+JNIEXPORT void JNICALL Java_org_scs_DirectSolver_csolveBuffers(JNIEnv *env, jclass clazz, jobject dJava,
+        jobject coneJava, jobject paramsJava, jobject solJava, jobject infoJava)
+#endif
+{
+    /* no copies: A, b and c are read from their buffers and the solution is
+     * written into those of solJava (and warm started from them) */
+    Data * d = getBufferDataStruct(env, dJava, paramsJava);
+    Cone * k;
+    Sol sol;
+    Info info = {0};
+    if (!d) {
+        return;
+    }
+    if (getBufferSol(env, solJava, &sol) < 0) {
+        freeBufferDataStruct(d);
+        return;
+    }
+    k = getConeStruct(env, coneJava);
+    scs(d, k, &sol, &info);
+    setInfo(env, infoJava, &info);
+    freeBufferDataStruct(d);
+    freeData(SCS_NULL, k);
+}
+
+#ifdef INDIRECTJ
+JNIEXPORT jlong JNICALL Java_org_scs_IndirectSolver_cinit(JNIEnv *env, jclass clazz, jobject dJava,
+        jobject coneJava, jobject paramsJava, jobject infoJava)
+#else
+JNIEXPORT jlong JNICALL Java_org_scs_DirectSolver_cinit(JNIEnv *env, jclass clazz, jobject dJava,
+        jobject coneJava, jobject paramsJava, jobject infoJava)
+#endif
+{
+    /* the buffers of dJava are read for the lifetime of the handle, b and c
+     * again on every solve */
+    JavaWork * jw;
+    Info info = {0};
+    Data * d = getBufferDataStruct(env, dJava, paramsJava);
+    if (!d) {
+        return 0;
+    }
+    jw = scs_calloc(1, sizeof(JavaWork));
+    jw->d = d;
+    jw->k = getConeStruct(env, coneJava);
+    jw->w = scs_init(jw->d, jw->k, &info);
+    jw->setupTime = info.setupTime;
+    setFloatUsingSetter(env, infoJava, info.setupTime, INFO_SETUP_TIME);
+    if (!jw->w) {
+        freeBufferDataStruct(jw->d);
+        freeData(SCS_NULL, jw->k);
+        scs_free(jw);
+        return 0;
+    }
+    return (jlong) (intptr_t) jw;
+}
+
+#ifdef INDIRECTJ
+JNIEXPORT void JNICALL Java_org_scs_IndirectSolver_csolveWork(JNIEnv *env, jclass clazz, jlong work,
+        jobject solJava, jboolean warmStart, jobject infoJava)
+#else
+JNIEXPORT void JNICALL Java_org_scs_DirectSolver_csolveWork(JNIEnv *env, jclass clazz, jlong work,
+        jobject solJava, jboolean warmStart, jobject infoJava)
+#endif
+{
+    JavaWork * jw = (JavaWork *) (intptr_t) work;
+    Sol sol;
+    Info info = {0};
+    if (getBufferSol(env, solJava, &sol) < 0) {
+        return;
+    }
+    jw->d->stgs->warm_start = warmStart ? 1 : 0;
+    scs_solve(jw->w, jw->d, jw->k, &sol, &info);
+    info.setupTime = jw->setupTime;
+    setInfo(env, infoJava, &info);
+}
+
+#ifdef INDIRECTJ
+JNIEXPORT void JNICALL Java_org_scs_IndirectSolver_cfinish(JNIEnv *env, jclass clazz, jlong work)
+#else
+JNIEXPORT void JNICALL Java_org_scs_DirectSolver_cfinish(JNIEnv *env, jclass clazz, jlong work)
+#endif
+{
+    JavaWork * jw = (JavaWork *) (intptr_t) work;
+    scs_finish(jw->w);
+    freeBufferDataStruct(jw->d);
+    freeData(SCS_NULL, jw->k);
+    scs_free(jw);
+}
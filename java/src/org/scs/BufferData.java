@@ -0,0 +1,94 @@
+package org.scs;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+public class BufferData {
+    /**
+     * A, b and c in direct buffers of native byte order, which the native
+     * solvers read in place rather than copying: A in column compressed
+     * format, size m by n. The buffers of a Workspace are read for its
+     * lifetime, b and c again on every solve, so they may be rewritten
+     * between solves.
+     */
+    private final ByteBuffer v; /* A values, doubles, size: NNZ A */
+    private final ByteBuffer i; /* A row index, ints, size: NNZ A */
+    private final ByteBuffer p; /* A col ptr, ints, size: n+1 */
+    private final ByteBuffer b; /* doubles, size: m */
+    private final ByteBuffer c; /* doubles, size: n */
+    private final int m;
+    private final int n;
+
+    public BufferData(int m, int n, ByteBuffer v, ByteBuffer i, ByteBuffer p, ByteBuffer b, ByteBuffer c) {
+        this.m = m;
+        this.n = n;
+        this.p = checkBuffer(p, "p", n + 1, 4);
+        int nnz = p.getInt(4 * n);
+        this.v = checkBuffer(v, "v", nnz, 8);
+        this.i = checkBuffer(i, "i", nnz, 4);
+        this.b = checkBuffer(b, "b", m, 8);
+        this.c = checkBuffer(c, "c", n, 8);
+    }
+
+    /* copies the data once into new buffers */
+    public BufferData(Data d) {
+        this(d.getA().getNumRows(), d.getA().getNumCols(), doubles(d.getA().getValues()),
+                ints(d.getA().getRowIdxs()), ints(d.getA().getColIdxs()), doubles(d.getB()),
+                doubles(d.getC()));
+    }
+
+    public ByteBuffer getValues() {
+        return v;
+    }
+
+    public ByteBuffer getRowIdxs() {
+        return i;
+    }
+
+    public ByteBuffer getColIdxs() {
+        return p;
+    }
+
+    public ByteBuffer getB() {
+        return b;
+    }
+
+    public ByteBuffer getC() {
+        return c;
+    }
+
+    public int getNumRows() {
+        return m;
+    }
+
+    public int getNumCols() {
+        return n;
+    }
+
+    /* Utilities: */
+    public static ByteBuffer allocate(int len, int width) {
+        return ByteBuffer.allocateDirect(len * width).order(ByteOrder.nativeOrder());
+    }
+
+    public static ByteBuffer doubles(double[] a) {
+        ByteBuffer buf = allocate(a.length, 8);
+        buf.asDoubleBuffer().put(a);
+        return buf;
+    }
+
+    public static ByteBuffer ints(int[] a) {
+        ByteBuffer buf = allocate(a.length, 4);
+        buf.asIntBuffer().put(a);
+        return buf;
+    }
+
+    static ByteBuffer checkBuffer(ByteBuffer buf, String name, int len, int width) {
+        if (buf == null || !buf.isDirect() || buf.order() != ByteOrder.nativeOrder()) {
+            throw new IllegalArgumentException(name + " must be a direct buffer of native byte order");
+        }
+        if (buf.capacity() < (long) len * width) {
+            throw new IllegalArgumentException(name + " must hold " + len + " entries");
+        }
+        return buf;
+    }
+}
@@ -0,0 +1,61 @@
+package org.scs;
+
+import java.nio.ByteBuffer;
+
+public class BufferSolution {
+    /**
+     * x, y and s in direct buffers of native byte order (see BufferData),
+     * which the native solvers write the solution into, and read the warm
+     * start from when warm starting.
+     */
+    private final ByteBuffer x; /* primal variable, doubles, size: n */
+    private final ByteBuffer y; /* dual variable, doubles, size: m */
+    private final ByteBuffer s; /* primal slack variable, doubles, size: m */
+    private final int m;
+    private final int n;
+
+    public BufferSolution(int m, int n) {
+        this(m, n, BufferData.allocate(n, 8), BufferData.allocate(m, 8), BufferData.allocate(m, 8));
+    }
+
+    public BufferSolution(int m, int n, ByteBuffer x, ByteBuffer y, ByteBuffer s) {
+        this.m = m;
+        this.n = n;
+        this.x = BufferData.checkBuffer(x, "x", n, 8);
+        this.y = BufferData.checkBuffer(y, "y", m, 8);
+        this.s = BufferData.checkBuffer(s, "s", m, 8);
+    }
+
+    public ByteBuffer getX() {
+        return x;
+    }
+    public ByteBuffer getY() {
+        return y;
+    }
+    public ByteBuffer getS() {
+        return s;
+    }
+
+    /* copies of the solution */
+    public double[] toX() {
+        return toArray(x, n);
+    }
+    public double[] toY() {
+        return toArray(y, m);
+    }
+    public double[] toS() {
+        return toArray(s, m);
+    }
+
+    void checkSize(BufferData d) {
+        if (d.getNumRows() != m || d.getNumCols() != n) {
+            throw new IllegalArgumentException("solution is not of the size of the data");
+        }
+    }
+
+    private static double[] toArray(ByteBuffer buf, int len) {
+        double[] a = new double[len];
+        buf.asDoubleBuffer().get(a);
+        return a;
+    }
+}
@@ -2,5 +2,9 @@ package org.scs;
 
 public interface IConeSolver {
     public void solve(Data d, Cone k, Settings p, Solution sol, Info info);
+    /* reads d and writes sol in place, warm starting from sol if p.isWarmStart() */
+    public void solve(BufferData d, Cone k, Settings p, BufferSolution sol, Info info);
+    /* sets up d for many solves, the workspace must be closed */
+    public Workspace init(BufferData d, Cone k, Settings p);
     public String version();
 }
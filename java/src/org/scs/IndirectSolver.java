@@ -6,6 +6,10 @@ public class IndirectSolver implements IConeSolver {
     }
 
     private static native void csolve(AMatrix A, double[] b, double[] c, Cone k, Settings p, Solution s, Info info);
+    private static native void csolveBuffers(BufferData d, Cone k, Settings p, BufferSolution s, Info info);
+    private static native long cinit(BufferData d, Cone k, Settings p, Info info);
+    private static native void csolveWork(long work, BufferSolution s, boolean warmStart, Info info);
+    private static native void cfinish(long work);
     private static native String cversion();
 
     private final static String VERSION = cversion();
@@ -14,6 +18,24 @@ public class IndirectSolver implements IConeSolver {
         csolve(d.getA(), d.getB(), d.getC(), k, p, sol, info);
     }
 
+    public void solve(BufferData d, Cone k, Settings p, BufferSolution sol, Info info) {
+        sol.checkSize(d);
+        csolveBuffers(d, k, p, sol, info);
+    }
+
+    public Workspace init(BufferData d, Cone k, Settings p) {
+        Info info = new Info();
+        return new Workspace(cinit(d, k, p, info), d, info) {
+            void csolveWork(long work, BufferSolution sol, boolean warmStart, Info info) {
+                IndirectSolver.csolveWork(work, sol, warmStart, info);
+            }
+
+            void cfinish(long work) {
+                IndirectSolver.cfinish(work);
+            }
+        };
+    }
+
     public String version() {
         return VERSION;
     }
@@ -13,6 +13,7 @@ public class Info {
     private double relGap; /* relative duality gap */
     private double setupTime; /* time taken for setup phase */
     private double solveTime; /* time taken for solve phase */
+    private double alpha; /* relaxation parameter at the end of the solve */
 
     public void setIter(int iter) {
         this.iter = iter;
@@ -62,6 +63,10 @@ public class Info {
         this.solveTime = solveTime;
     }
 
+    public void setAlpha(double alpha) {
+        this.alpha = alpha;
+    }
+
     public int getIter() {
         return iter;
     }
@@ -109,4 +114,8 @@ public class Info {
     public double getSolveTime() {
         return solveTime;
     }
+
+    public double getAlpha() {
+        return alpha;
+    }
 }
@@ -4,13 +4,17 @@ public class Settings {
     // set to defaults:
     private int maxIters = 2500;        /* maximum iterations to take: 2500 */
     private double eps = 1e-3;          /* convergence tolerance: 1e-3 */
-    private double alpha = 1.8;         /* relaxation parameter: 1.8 */
+    private double alpha = 1.5;         /* relaxation parameter: 1.5 */
     private double rhoX = 1e-3;;        /* x equality constraint scaling: 1e-3 */
     private double cgRate = 2;          /* for indirect, tolerance goes down like (1/iter)^cg_rate: 2 */
     private boolean verbose = true;     /* boolean, write out progress: 1 */
     private boolean normalize = true;   /* boolean, heuristic data rescaling: 1 */
     private double scale = 5;           /* if normalized, rescales by this factor: 5 */
     private boolean warmStart = false;  /* boolean, warm start (put initial guess in Sol struct): 0 */
+    private boolean polish = false;     /* boolean, polish the solution after convergence, direct solver only: 0 */
+    private int adaptScale = 0;         /* max updates of scale from the residual balance per solve, 0 disables: 0 */
+    private boolean adaptAlpha = false; /* boolean, adapt alpha from the contraction of the fixed point residual: 0 */
+    private boolean stallStop = false;  /* boolean, stop as inaccurate when the residuals stop improving: 0 */
 
     // getters:
     public int getMaxIters() {
@@ -40,6 +44,18 @@ public class Settings {
     public boolean isWarmStart() {
         return warmStart;
     }
+    public boolean isPolish() {
+        return polish;
+    }
+    public int getAdaptScale() {
+        return adaptScale;
+    }
+    public boolean isAdaptAlpha() {
+        return adaptAlpha;
+    }
+    public boolean isStallStop() {
+        return stallStop;
+    }
 
     // setters:
     public void setMaxIters(int maxIters) {
@@ -69,4 +85,16 @@ public class Settings {
     public void setWarmStart(boolean warmStart) {
         this.warmStart = warmStart;
     }
+    public void setPolish(boolean polish) {
+        this.polish = polish;
+    }
+    public void setAdaptScale(int adaptScale) {
+        this.adaptScale = adaptScale;
+    }
+    public void setAdaptAlpha(boolean adaptAlpha) {
+        this.adaptAlpha = adaptAlpha;
+    }
+    public void setStallStop(boolean stallStop) {
+        this.stallStop = stallStop;
+    }
 }
@@ -0,0 +1,52 @@
+package org.scs;
+
+public abstract class Workspace implements AutoCloseable {
+    /**
+     * A problem set up once by IConeSolver.init (A normalized and, for the
+     * direct solver, factored) and then solved many times for the current
+     * contents of the b and c buffers. Holds native memory until closed.
+     * One call at a time.
+     */
+    private long work; /* native handle */
+    private final BufferData d;
+    private final double setupTime;
+
+    Workspace(long work, BufferData d, Info info) {
+        if (work == 0) {
+            throw new IllegalArgumentException("failed to set up the problem, see the solver output");
+        }
+        this.work = work;
+        this.d = d;
+        this.setupTime = info.getSetupTime();
+    }
+
+    abstract void csolveWork(long work, BufferSolution sol, boolean warmStart, Info info);
+
+    abstract void cfinish(long work);
+
+    /* writes the solution into sol, warm started from its contents if warmStart */
+    public synchronized Info solve(BufferSolution sol, boolean warmStart) {
+        if (work == 0) {
+            throw new IllegalStateException("workspace is closed");
+        }
+        sol.checkSize(d);
+        Info info = new Info();
+        csolveWork(work, sol, warmStart, info);
+        return info;
+    }
+
+    public BufferData getData() {
+        return d;
+    }
+
+    public double getSetupTime() {
+        return setupTime;
+    }
+
+    public synchronized void close() {
+        if (work != 0) {
+            cfinish(work);
+            work = 0;
+        }
+    }
+}
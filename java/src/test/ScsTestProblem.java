@@ -46,5 +46,26 @@ public class ScsTestProblem {
         System.out.println("resDual " + sol.getInfo().getResDual());
         System.out.println("relGap " + sol.getInfo().getRelGap());
         System.out.println("setup time " + sol.getInfo().getSetupTime());
+
+        /* direct buffers, read and written in place, and a workspace set up
+         * once for many solves with new b */
+        Cone k = new Cone();
+        k.setL(m); // that of RandomLinearProgram
+        BufferData bd = new BufferData(d);
+        BufferSolution bsol = new BufferSolution(m, n);
+        Info info = new Info();
+        dsolver.solve(bd, k, p, bsol, info);
+        System.out.println("buffers: c'x = " + Utils.ip(bsol.toX(), d.getC()) + ", status " + info.getStatus());
+
+        p.setVerbose(false);
+        try (Workspace work = dsolver.init(bd, k, p)) {
+            System.out.println("workspace setup time " + work.getSetupTime());
+            for (int t = 0; t < 3; t++) {
+                bd.getB().asDoubleBuffer().put(0, d.getB()[0] + t);
+                info = work.solve(bsol, t > 0);
+                System.out.println("solve " + t + ": iters " + info.getIter() + ", status " + info.getStatus()
+                        + ", solve time " + info.getSolveTime());
+            }
+        }
     }
 }
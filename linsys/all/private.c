@@ -0,0 +1,53 @@
+#include "glbopts.h"
+#include "scs.h"
+#include "../amatrix.h"
+
+/* picks among the backends linked together, see selectLinSys in linSys.h;
+ * built with ALL_LINSYS, which drops the selectors of the backends
+ * themselves */
+
+/* solves assumed when comparing setup plus solve costs */
+#define AUTO_ITERS 250
+/* the dense backend is picked when n + m is at most this and at least this
+ * fraction of the entries of A are nonzero */
+#define DENSE_MAX_DIM 1000
+#define DENSE_MIN_DENSITY 0.2
+/* up to this n + m the direct backend is picked without estimating costs,
+ * which would form and order the KKT matrix once more */
+#define DIRECT_MAX_DIM 200
+
+const LinSys *selectLinSys(const AMatrix *A, const Settings *stgs) {
+    scs_int iters;
+    scs_float direct, indirect;
+    switch (stgs->linsys) {
+    case LINSYS_DIRECT:
+        return &directLinSys;
+    case LINSYS_INDIRECT:
+        return &indirectLinSys;
+#ifdef LAPACK_LIB_FOUND
+    case LINSYS_DENSE:
+        return &denseLinSys;
+#endif
+    case LINSYS_AUTO:
+        break;
+    default:
+        return SCS_NULL;
+    }
+#ifdef LAPACK_LIB_FOUND
+    if (A->n + A->m <= DENSE_MAX_DIM &&
+        A->p[A->n] >= DENSE_MIN_DENSITY * A->m * A->n) {
+        return &denseLinSys;
+    }
+#endif
+    if (A->n + A->m <= DIRECT_MAX_DIM) {
+        return &directLinSys;
+    }
+    iters = MIN(stgs->max_iters, AUTO_ITERS);
+    direct = directLinSys.estimateCost(A, stgs, iters);
+    indirect = indirectLinSys.estimateCost(A, stgs, iters);
+#if EXTRAVERBOSE > 0
+    scs_printf("predicted flops: direct %.3e, indirect %.3e\n", direct,
+               indirect);
+#endif
+    return direct >= 0 && direct <= indirect ? &directLinSys : &indirectLinSys;
+}
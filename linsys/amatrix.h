@@ -12,6 +12,10 @@ struct A_DATA_MATRIX {
     scs_int *i;   /* A row index, size: NNZ A */
     scs_int *p;   /* A column pointer, size: n+1 */
     scs_int m, n; /* m rows, n cols */
+    /* optional dense low rank term, the data matrix is then A + U V' */
+    scs_int rank; /* columns of U and V, 0 if there is no such term */
+    scs_float *U; /* column major, size: m * rank */
+    scs_float *V; /* column major, size: n * rank */
 };
 
 #ifdef __cplusplus
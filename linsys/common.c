@@ -21,19 +21,46 @@ scs_int copyAMatrix(AMatrix **dstp, const AMatrix *src) {
     memcpy(A->x, src->x, sizeof(scs_float) * Anz);
     memcpy(A->i, src->i, sizeof(scs_int) * Anz);
     memcpy(A->p, src->p, sizeof(scs_int) * (src->n + 1));
+    if (src->rank > 0) {
+        A->rank = src->rank;
+        A->U = scs_malloc(sizeof(scs_float) * src->m * src->rank);
+        A->V = scs_malloc(sizeof(scs_float) * src->n * src->rank);
+        if (!A->U || !A->V)
+            return 0;
+        memcpy(A->U, src->U, sizeof(scs_float) * src->m * src->rank);
+        memcpy(A->V, src->V, sizeof(scs_float) * src->n * src->rank);
+    }
     *dstp = A;
     return 1;
 }
 
+scs_int copyAMatrixValues(AMatrix *dst, const AMatrix *src) {
+    scs_int Anz = src->p[src->n];
+    if (src->m != dst->m || src->n != dst->n || Anz != dst->p[dst->n] ||
+        src->rank != dst->rank) {
+        return -1;
+    }
+    memcpy(dst->x, src->x, sizeof(scs_float) * Anz);
+    if (src->rank > 0) {
+        memcpy(dst->U, src->U, sizeof(scs_float) * src->m * src->rank);
+        memcpy(dst->V, src->V, sizeof(scs_float) * src->n * src->rank);
+    }
+    return 0;
+}
+
 scs_int validateLinSys(const AMatrix *A) {
     scs_int i, rMax, Anz;
     if (!A->x || !A->i || !A->p) {
         scs_printf("data incompletely specified\n");
         return -1;
     }
+    if (A->rank < 0 || (A->rank > 0 && (!A->U || !A->V))) {
+        scs_printf("low rank term of A incompletely specified\n");
+        return -1;
+    }
     /* detects some errors in A col ptrs: */
     for (i = 0; i < A->n; ++i) {
-        if (A->p[i] == A->p[i + 1]) {
+        if (A->p[i] == A->p[i + 1] && A->rank == 0) {
             scs_printf("WARN: A->p (column pointers) not strictly increasing, "
                        "column %li empty\n",
                        (long)i);
@@ -43,7 +70,8 @@ scs_int validateLinSys(const AMatrix *A) {
         }
     }
     Anz = A->p[A->n];
-    if (((scs_float)Anz / A->m > A->n) || (Anz <= 0)) {
+    if (((scs_float)Anz / A->m > A->n) || (Anz < 0) ||
+        (Anz == 0 && A->rank == 0)) {
         scs_printf("Anz (nonzeros in A) = %li, outside of valid range\n",
                    (long)Anz);
         return -1;
@@ -67,6 +95,10 @@ void freeAMatrix(AMatrix *A) {
         scs_free(A->i);
     if (A->p)
         scs_free(A->p);
+    if (A->U)
+        scs_free(A->U);
+    if (A->V)
+        scs_free(A->V);
     scs_free(A);
 }
 
@@ -88,18 +120,17 @@ void printAMatrix(const AMatrix *A) {
     }
 }
 
-void normalizeA(AMatrix *A, const Settings *stgs, const Cone *k,
-                Scaling *scal) {
+void normalizeA(AMatrix *A, scs_float scale, const Cone *k, Scaling *scal) {
     scs_float *D = scs_malloc(A->m * sizeof(scs_float));
     scs_float *E = scs_malloc(A->n * sizeof(scs_float));
     scs_float *Dt = scs_malloc(A->m * sizeof(scs_float));
     scs_float *Et = scs_malloc(A->n * sizeof(scs_float));
-    scs_float *nms = scs_calloc(A->m, sizeof(scs_float));
+    scs_float *nms = scs_malloc(A->m * sizeof(scs_float));
     scs_float minRowScale = MIN_SCALE * SQRTF((scs_float)A->n),
               maxRowScale = MAX_SCALE * SQRTF((scs_float)A->n);
     scs_float minColScale = MIN_SCALE * SQRTF((scs_float)A->m),
               maxColScale = MAX_SCALE * SQRTF((scs_float)A->m);
-    scs_int i, j, l, count, delta, *boundaries, c1, c2;
+    scs_int i, j, l, count, delta, *boundaries, c1;
     scs_float wrk, e;
     scs_int numBoundaries = getConeBoundaries(k, &boundaries);
 
@@ -111,17 +142,8 @@ void normalizeA(AMatrix *A, const Settings *stgs, const Cone *k,
 #endif
 
     for (l = 0; l < NUM_SCALE_PASSES; ++l) {
-        memset(D, 0, A->m * sizeof(scs_float));
-        memset(E, 0, A->n * sizeof(scs_float));
         /* calculate row norms */
-        for (i = 0; i < A->n; ++i) {
-            c1 = A->p[i];
-            c2 = A->p[i + 1];
-            for (j = c1; j < c2; ++j) {
-                wrk = A->x[j];
-                D[A->i[j]] += wrk * wrk;
-            }
-        }
+        rowNormsSqA(A, D);
         for (i = 0; i < A->m; ++i) {
             D[i] = SQRTF(D[i]); /* just the norms */
         }
@@ -154,15 +176,24 @@ void normalizeA(AMatrix *A, const Settings *stgs, const Cone *k,
                 A->x[j] /= D[A->i[j]];
             }
         }
+        for (j = 0; j < A->rank; ++j) {
+            for (i = 0; i < A->m; ++i) {
+                A->U[j * A->m + i] /= D[i];
+            }
+        }
         /* calculate and scale by col norms, E */
+        colNormsSqA(A, E);
         for (i = 0; i < A->n; ++i) {
             c1 = A->p[i + 1] - A->p[i];
-            e = calcNorm(&(A->x[A->p[i]]), c1);
+            e = SQRTF(E[i]);
             if (e < minColScale)
                 e = 1;
             else if (e > maxColScale)
                 e = maxColScale;
             scaleArray(&(A->x[A->p[i]]), 1.0 / e, c1);
+            for (j = 0; j < A->rank; ++j) {
+                A->V[j * A->n + i] /= e;
+            }
             E[i] = e;
         }
 
@@ -178,12 +209,7 @@ void normalizeA(AMatrix *A, const Settings *stgs, const Cone *k,
     scs_free(E);
 
     /* calculate mean of row norms of A */
-    for (i = 0; i < A->n; ++i) {
-        for (j = A->p[i]; j < A->p[i + 1]; ++j) {
-            wrk = A->x[j];
-            nms[A->i[j]] += wrk * wrk;
-        }
-    }
+    rowNormsSqA(A, nms);
     scal->meanNormRowA = 0.0;
     for (i = 0; i < A->m; ++i) {
         scal->meanNormRowA += SQRTF(nms[i]) / A->m;
@@ -191,15 +217,17 @@ void normalizeA(AMatrix *A, const Settings *stgs, const Cone *k,
     scs_free(nms);
 
     /* calculate mean of col norms of A */
+    nms = scs_malloc(A->n * sizeof(scs_float));
+    colNormsSqA(A, nms);
     scal->meanNormColA = 0.0;
     for (i = 0; i < A->n; ++i) {
-        c1 = A->p[i + 1] - A->p[i];
-        scal->meanNormColA += calcNorm(&(A->x[A->p[i]]), c1) / A->n;
+        scal->meanNormColA += SQRTF(nms[i]) / A->n;
     }
+    scs_free(nms);
 
     /* scale up by d->SCALE if not equal to 1 */
-    if (stgs->scale != 1) {
-        scaleArray(A->x, stgs->scale, A->p[A->n]);
+    if (scale != 1) {
+        scaleAMatrix(A, scale);
     }
 
     scal->D = Dt;
@@ -212,18 +240,128 @@ void normalizeA(AMatrix *A, const Settings *stgs, const Cone *k,
 #endif
 }
 
-void unNormalizeA(AMatrix *A, const Settings *stgs, const Scaling *scal) {
+void unNormalizeA(AMatrix *A, scs_float scale, const Scaling *scal) {
     scs_int i, j;
     scs_float *D = scal->D;
     scs_float *E = scal->E;
     for (i = 0; i < A->n; ++i) {
-        scaleArray(&(A->x[A->p[i]]), E[i] / stgs->scale, A->p[i + 1] - A->p[i]);
+        scaleArray(&(A->x[A->p[i]]), E[i] / scale, A->p[i + 1] - A->p[i]);
     }
     for (i = 0; i < A->n; ++i) {
         for (j = A->p[i]; j < A->p[i + 1]; ++j) {
             A->x[j] *= D[A->i[j]];
         }
     }
+    for (j = 0; j < A->rank; ++j) {
+        for (i = 0; i < A->m; ++i) {
+            A->U[j * A->m + i] *= D[i] / scale;
+        }
+        for (i = 0; i < A->n; ++i) {
+            A->V[j * A->n + i] *= E[i];
+        }
+    }
+}
+
+void scaleAMatrix(AMatrix *A, scs_float f) {
+    scaleArray(A->x, f, A->p[A->n]);
+    if (A->rank > 0) {
+        scaleArray(A->U, f, A->m * A->rank);
+    }
+}
+
+/* squared norms of the rows of A + U V', with S = A (the sparse part):
+ * |S_i|^2 + 2 U_i (S V)_i' + U_i (V'V) U_i', costing O(nnz rank + (m + n)
+ * rank^2) without forming U V' */
+void rowNormsSqA(const AMatrix *A, scs_float *nms) {
+    scs_int i, j, k, l, q, m = A->m, n = A->n, r = A->rank;
+    scs_float *SV, *G, wrk;
+    memset(nms, 0, m * sizeof(scs_float));
+    for (j = 0; j < n; ++j) {
+        for (q = A->p[j]; q < A->p[j + 1]; ++q) {
+            nms[A->i[q]] += A->x[q] * A->x[q];
+        }
+    }
+    if (r <= 0) {
+        return;
+    }
+    SV = scs_calloc(m * r, sizeof(scs_float));
+    G = scs_malloc(r * r * sizeof(scs_float));
+    for (k = 0; k < r; ++k) {
+        for (j = 0; j < n; ++j) {
+            for (q = A->p[j]; q < A->p[j + 1]; ++q) {
+                SV[k * m + A->i[q]] += A->x[q] * A->V[k * n + j];
+            }
+        }
+        for (l = 0; l < r; ++l) {
+            G[k * r + l] = innerProd(&(A->V[k * n]), &(A->V[l * n]), n);
+        }
+    }
+    for (i = 0; i < m; ++i) {
+        for (k = 0; k < r; ++k) {
+            wrk = 2 * SV[k * m + i];
+            for (l = 0; l < r; ++l) {
+                wrk += G[k * r + l] * A->U[l * m + i];
+            }
+            nms[i] += A->U[k * m + i] * wrk;
+        }
+    }
+    scs_free(SV);
+    scs_free(G);
+}
+
+/* squared norms of the columns of A + U V', as rowNormsSqA on the transpose */
+void colNormsSqA(const AMatrix *A, scs_float *nms) {
+    scs_int j, k, l, q, m = A->m, n = A->n, r = A->rank;
+    scs_float *SU, *G, wrk;
+    for (j = 0; j < n; ++j) {
+        nms[j] = calcNormSq(&(A->x[A->p[j]]), A->p[j + 1] - A->p[j]);
+    }
+    if (r <= 0) {
+        return;
+    }
+    SU = scs_malloc(r * sizeof(scs_float));
+    G = scs_malloc(r * r * sizeof(scs_float));
+    for (k = 0; k < r; ++k) {
+        for (l = 0; l < r; ++l) {
+            G[k * r + l] = innerProd(&(A->U[k * m]), &(A->U[l * m]), m);
+        }
+    }
+    for (j = 0; j < n; ++j) {
+        /* row j of S'U */
+        for (k = 0; k < r; ++k) {
+            SU[k] = 0;
+            for (q = A->p[j]; q < A->p[j + 1]; ++q) {
+                SU[k] += A->x[q] * A->U[k * m + A->i[q]];
+            }
+        }
+        for (k = 0; k < r; ++k) {
+            wrk = 2 * SU[k];
+            for (l = 0; l < r; ++l) {
+                wrk += G[k * r + l] * A->V[l * n + j];
+            }
+            nms[j] += A->V[k * n + j] * wrk;
+        }
+    }
+    scs_free(SU);
+    scs_free(G);
+}
+
+/* y += U V'x, one inner product and one axpy per column of the factors */
+void accumByLowRank(const AMatrix *A, const scs_float *x, scs_float *y) {
+    scs_int k;
+    for (k = 0; k < A->rank; ++k) {
+        addScaledArray(y, &(A->U[k * A->m]), A->m,
+                       innerProd(&(A->V[k * A->n]), x, A->n));
+    }
+}
+
+/* y += V U'x */
+void accumByLowRankTrans(const AMatrix *A, const scs_float *x, scs_float *y) {
+    scs_int k;
+    for (k = 0; k < A->rank; ++k) {
+        addScaledArray(y, &(A->V[k * A->n]), A->n,
+                       innerProd(&(A->U[k * A->m]), x, A->m));
+    }
 }
 
 void _accumByAtrans(scs_int n, scs_float *Ax, scs_int *Ai, scs_int *Ap,
@@ -10,6 +10,10 @@ extern "C" {
 
 void _accumByAtrans(scs_int n, scs_float *Ax, scs_int *Ai, scs_int *Ap,
                     const scs_float *x, scs_float *y);
+void accumByLowRank(const AMatrix *A, const scs_float *x, scs_float *y);
+void accumByLowRankTrans(const AMatrix *A, const scs_float *x, scs_float *y);
+void rowNormsSqA(const AMatrix *A, scs_float *nms);
+void colNormsSqA(const AMatrix *A, scs_float *nms);
 void _accumByA(scs_int n, scs_float *Ax, scs_int *Ai, scs_int *Ap,
                const scs_float *x, scs_float *y);
 
@@ -0,0 +1,174 @@
+#include "private.h"
+
+/* dense LAPACK solver for small problems where A is mostly full: the KKT
+ * system is reduced to the smaller of its two Schur complements, which is
+ * positive definite, and that is factored with potrf */
+
+void BLAS(gemv)(const char *trans, const blasint *m, const blasint *n,
+                const scs_float *alpha, const scs_float *a, const blasint *lda,
+                const scs_float *x, const blasint *incx, const scs_float *beta,
+                scs_float *y, const blasint *incy);
+void BLAS(syrk)(const char *uplo, const char *trans, const blasint *n,
+                const blasint *k, const scs_float *alpha, const scs_float *a,
+                const blasint *lda, const scs_float *beta, scs_float *c,
+                const blasint *ldc);
+void BLAS(potrf)(const char *uplo, const blasint *n, scs_float *a,
+                 const blasint *lda, blasint *info);
+void BLAS(potrs)(const char *uplo, const blasint *n, const blasint *nrhs,
+                 const scs_float *a, const blasint *lda, scs_float *b,
+                 const blasint *ldb, blasint *info);
+
+static char *getLinSysMethod(const AMatrix *A, const Settings *s) {
+    char *str = scs_malloc(sizeof(char) * 128);
+    sprintf(str, "dense-direct, nnz in A = %li, factor order %li",
+            (long)A->p[A->n], (long)MIN(A->n, A->m));
+    return str;
+}
+
+static char *getLinSysSummary(Priv *p, const Info *info) {
+    char *str = scs_malloc(sizeof(char) * 128);
+    sprintf(str, "\tLin-sys: avg solve time: %1.2es\n",
+            p->totalSolveTime / (info->iter + 1) / 1e3);
+    p->totalSolveTime = 0;
+    return str;
+}
+
+static void freePriv(Priv *p) {
+    if (p) {
+        if (p->Ad)
+            scs_free(p->Ad);
+        if (p->G)
+            scs_free(p->G);
+        if (p->tmp)
+            scs_free(p->tmp);
+        scs_free(p);
+    }
+}
+
+/* forms y += A'*x */
+static void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
+                          scs_float *y) {
+    blasint m = A->m, n = A->n, one = 1;
+    scs_float onef = 1.0;
+    BLAS(gemv)("Transpose", &m, &n, &onef, p->Ad, &m, x, &one, &onef, y, &one);
+}
+
+/* forms y += A*x */
+static void accumByA(const AMatrix *A, Priv *p, const scs_float *x,
+                     scs_float *y) {
+    blasint m = A->m, n = A->n, one = 1;
+    scs_float onef = 1.0;
+    BLAS(gemv)("NoTranspose", &m, &n, &onef, p->Ad, &m, x, &one, &onef, y,
+               &one);
+}
+
+/* copies A, with its low rank term, into p->Ad and factors the Schur complement into p->G */
+static scs_int factorize(const AMatrix *A, const Settings *stgs, Priv *p) {
+    blasint m = A->m, n = A->n, info;
+    scs_float onef = 1.0, zerof = 0.0;
+    scs_int i, j, l;
+    memset(p->Ad, 0, A->m * A->n * sizeof(scs_float));
+    for (j = 0; j < A->n; ++j) {
+        for (i = A->p[j]; i < A->p[j + 1]; ++i) {
+            p->Ad[j * A->m + A->i[i]] += A->x[i];
+        }
+    }
+    for (l = 0; l < A->rank; ++l) {
+        for (j = 0; j < A->n; ++j) {
+            addScaledArray(&(p->Ad[j * A->m]), &(A->U[l * A->m]), A->m,
+                           A->V[l * A->n + j]);
+        }
+    }
+    if (n <= m) {
+        BLAS(syrk)("Lower", "Transpose", &p->k, &m, &onef, p->Ad, &m, &zerof,
+                   p->G, &p->k);
+    } else {
+        BLAS(syrk)("Lower", "NoTranspose", &p->k, &n, &onef, p->Ad, &m,
+                   &zerof, p->G, &p->k);
+    }
+    for (i = 0; i < p->k; ++i) {
+        p->G[i * p->k + i] += stgs->rho_x;
+    }
+    BLAS(potrf)("Lower", &p->k, p->G, &p->k, &info);
+    return info == 0 ? 0 : -1;
+}
+
+static scs_int updateLinSys(const AMatrix *A, const Settings *stgs, Priv *p) {
+    return factorize(A, stgs, p);
+}
+
+static Priv *initPriv(const AMatrix *A, const Settings *stgs) {
+    Priv *p = scs_calloc(1, sizeof(Priv));
+    if (!p) {
+        return SCS_NULL;
+    }
+    p->k = MIN(A->n, A->m);
+    p->Ad = scs_malloc(A->m * A->n * sizeof(scs_float));
+    p->G = scs_malloc(p->k * p->k * sizeof(scs_float));
+    p->tmp = scs_malloc(A->m * sizeof(scs_float));
+    if (!p->Ad || !p->G || !p->tmp || factorize(A, stgs, p) < 0) {
+        freePriv(p);
+        return SCS_NULL;
+    }
+    p->totalSolveTime = 0.0;
+    return p;
+}
+
+static scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                           scs_float *b, const scs_float *s, scs_int iter) {
+    /* the first row gives rho_x * x = b[0:n] - A'y, the second y = Ax -
+     * b[n:n+m], whichever of x and y is the shorter is found from the Schur
+     * complement, and y is formed last so that the second row holds */
+    blasint m = A->m, n = A->n, one = 1, info;
+    scs_float onef = 1.0, negOnef = -1.0;
+    timer linsysTimer;
+    tic(&linsysTimer);
+    if (n <= m) {
+        /* (rho_x * I + A'A) x = b[0:n] + A'b[n:n+m] */
+        accumByAtrans(A, p, &(b[A->n]), b);
+        BLAS(potrs)("Lower", &p->k, &one, p->G, &p->k, b, &p->k, &info);
+    } else {
+        /* (rho_x * I + AA') y = A b[0:n] - rho_x * b[n:n+m] */
+        memcpy(p->tmp, &(b[A->n]), A->m * sizeof(scs_float));
+        scaleArray(p->tmp, -stgs->rho_x, A->m);
+        accumByA(A, p, b, p->tmp);
+        BLAS(potrs)("Lower", &p->k, &one, p->G, &p->k, p->tmp, &p->k, &info);
+        BLAS(gemv)("Transpose", &m, &n, &negOnef, p->Ad, &m, p->tmp, &one,
+                   &onef, b, &one);
+        scaleArray(b, 1.0 / stgs->rho_x, A->n);
+    }
+    scaleArray(&(b[A->n]), -1, A->m);
+    accumByA(A, p, b, &(b[A->n]));
+    p->totalSolveTime += tocq(&linsysTimer);
+#if EXTRAVERBOSE > 0
+    scs_printf("linsys solve time: %1.2es\n", tocq(&linsysTimer) / 1e3);
+#endif
+    return info == 0 ? 0 : -1;
+}
+
+/* polishing needs the active rows of A, only the direct solver supports it */
+static scs_int solvePolishSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                              const scs_int *active, const scs_float *b,
+                              scs_float *x) {
+    return -1;
+}
+
+/* the setup copies A, forms the Schur complement with syrk and factors it,
+ * a solve is two or three multiplies by A or A' and two triangular solves */
+static scs_float estimateCost(const AMatrix *A, const Settings *stgs,
+                              scs_int iters) {
+    scs_float mn = (scs_float)A->m * A->n, k = MIN(A->n, A->m);
+    return mn + mn * k + k * k * k / 3 + iters * (6 * mn + 2 * k * k);
+}
+
+const LinSys denseLinSys = {LINSYS_DENSE, initPriv, solveLinSys, updateLinSys,
+                            solvePolishSys, freePriv, accumByAtrans, accumByA,
+                            getLinSysMethod, getLinSysSummary, estimateCost};
+
+#ifndef ALL_LINSYS
+const LinSys *selectLinSys(const AMatrix *A, const Settings *stgs) {
+    return stgs->linsys == LINSYS_AUTO || stgs->linsys == LINSYS_DENSE
+               ? &denseLinSys
+               : SCS_NULL;
+}
+#endif
@@ -0,0 +1,21 @@
+#ifndef PRIV_H_GUARD
+#define PRIV_H_GUARD
+
+#include "glbopts.h"
+#include "scs.h"
+#include "scs_blas.h"
+#include "../common.h"
+#include "linAlg.h"
+
+struct PRIVATE_DATA {
+    scs_float *Ad; /* A stored densely, column major, m x n */
+    /* lower Cholesky factor of rho_x * I + A'A if n <= m, else of
+     * rho_x * I + AA', of order k = min(n, m) */
+    scs_float *G;
+    blasint k;
+    scs_float *tmp; /* workspace, size m */
+    /* reporting */
+    scs_float totalSolveTime;
+};
+
+#endif
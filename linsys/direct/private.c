@@ -1,12 +1,18 @@
 #include "private.h"
 
-char *getLinSysMethod(const AMatrix *A, const Settings *s) {
+/* regularization and refinement steps of the polishing system */
+#define POLISH_DELTA (1e-7)
+#define POLISH_REFINE_ITERS (3)
+/* KKT matrices up to this order are ordered by blocks rather than by AMD */
+#define BLOCK_ORDER_MAX_DIM (64)
+
+static char *getLinSysMethod(const AMatrix *A, const Settings *s) {
     char *tmp = scs_malloc(sizeof(char) * 128);
     sprintf(tmp, "sparse-direct, nnz in A = %li", (long)A->p[A->n]);
     return tmp;
 }
 
-char *getLinSysSummary(Priv *p, const Info *info) {
+static char *getLinSysSummary(Priv *p, const Info *info) {
     char *str = scs_malloc(sizeof(char) * 128);
     scs_int n = p->L->n;
     sprintf(str, "\tLin-sys: nnz in L factor: %li, avg solve time: %1.2es\n",
@@ -15,7 +21,7 @@ char *getLinSysSummary(Priv *p, const Info *info) {
     return str;
 }
 
-void freePriv(Priv *p) {
+static void freePriv(Priv *p) {
     if (p) {
         if (p->L)
             cs_spfree(p->L);
@@ -25,62 +31,82 @@ void freePriv(Priv *p) {
             scs_free(p->D);
         if (p->bp)
             scs_free(p->bp);
+        if (p->Z)
+            scs_free(p->Z);
+        if (p->C)
+            scs_free(p->C);
+        if (p->piv)
+            scs_free(p->piv);
+        if (p->t)
+            scs_free(p->t);
         scs_free(p);
     }
 }
 
-cs *formKKT(const AMatrix *A, const Settings *s) {
-    /* ONLY UPPER TRIANGULAR PART IS STUFFED
-     * forms column compressed KKT matrix
-     * assumes column compressed form A matrix
-     *
-     * forms upper triangular part of [I A'; A -I]
-     */
-    scs_int j, k, kk;
-    cs *K_cs;
-    /* I at top left */
-    const scs_int Anz = A->p[A->n];
-    const scs_int Knzmax = A->n + A->m + Anz;
-    cs *K = cs_spalloc(A->m + A->n, A->m + A->n, Knzmax, 1, 1);
-
-#if EXTRAVERBOSE > 0
-    scs_printf("forming KKT\n");
-#endif
-
+/* upper triangular part of [xDiag I, A_a'; A_a, yDiag I], where A_a is A
+ * restricted to the active rows (all rows if active is null), with a unit
+ * diagonal on the inactive rows; assembled in compressed columns directly,
+ * column n + i holding row i of A and then the diagonal */
+static cs *assembleKKT(const AMatrix *A, const scs_int *active,
+                       scs_float xDiag, scs_float yDiag) {
+    scs_int i, j, k, q, n = A->n, m = A->m, *Kp, *Ki;
+    scs_float *Kx;
+    cs *K = cs_spalloc(n + m, n + m, n + m + A->p[n], 1, 0);
     if (!K) {
         return SCS_NULL;
     }
-    kk = 0;
-    for (k = 0; k < A->n; k++) {
-        K->i[kk] = k;
-        K->p[kk] = k;
-        K->x[kk] = s->rho_x;
-        kk++;
+    Kp = K->p;
+    Ki = K->i;
+    Kx = K->x;
+    for (j = 0; j < n; j++) {
+        Kp[j] = j;
+        Ki[j] = j;
+        Kx[j] = xDiag;
+    }
+    Kp[n] = n;
+    if (m == 0) {
+        return K;
+    }
+    /* Kp[n + 1 + i] is first the start of column n + i, and is moved along
+     * it as the column is filled, ending as the start of column n + i + 1 */
+    memset(&(Kp[n + 1]), 0, m * sizeof(scs_int));
+    for (k = 0; k < A->p[n]; k++) {
+        i = A->i[k];
+        if (i + 1 < m && (!active || active[i])) {
+            Kp[n + 2 + i]++;
+        }
+    }
+    Kp[n + 1] = n;
+    for (i = 1; i < m; i++) {
+        Kp[n + 1 + i] += Kp[n + i] + 1;
     }
-    /* A^T at top right : CCS: */
-    for (j = 0; j < A->n; j++) {
+    for (j = 0; j < n; j++) {
         for (k = A->p[j]; k < A->p[j + 1]; k++) {
-            K->p[kk] = A->i[k] + A->n;
-            K->i[kk] = j;
-            K->x[kk] = A->x[k];
-            kk++;
+            i = A->i[k];
+            if (!active || active[i]) {
+                q = Kp[n + 1 + i]++;
+                Ki[q] = j;
+                Kx[q] = A->x[k];
+            }
         }
     }
-    /* -I at bottom right */
-    for (k = 0; k < A->m; k++) {
-        K->i[kk] = k + A->n;
-        K->p[kk] = k + A->n;
-        K->x[kk] = -1;
-        kk++;
+    for (i = 0; i < m; i++) {
+        q = Kp[n + 1 + i]++;
+        Ki[q] = n + i;
+        Kx[q] = !active || active[i] ? yDiag : 1;
     }
-    /* assert kk == Knzmax */
-    K->nz = Knzmax;
-    K_cs = cs_compress(K);
-    cs_spfree(K);
-    return (K_cs);
+    return K;
+}
+
+/* upper triangular part of [rho_x I, A'; A, -I] */
+static cs *formKKT(const AMatrix *A, const Settings *s) {
+#if EXTRAVERBOSE > 0
+    scs_printf("forming KKT\n");
+#endif
+    return assembleKKT(A, SCS_NULL, s->rho_x, -1);
 }
 
-scs_int LDLInit(cs *A, scs_int P[], scs_float **info) {
+static scs_int LDLInit(cs *A, scs_int P[], scs_float **info) {
     *info = (scs_float *)scs_malloc(AMD_INFO * sizeof(scs_float));
 #ifdef DLONG
     return (amd_l_order(A->n, A->p, A->i, P, (scs_float *)SCS_NULL, *info));
@@ -89,7 +115,8 @@ scs_int LDLInit(cs *A, scs_int P[], scs_float **info) {
 #endif
 }
 
-scs_int LDLFactor(cs *A, scs_int P[], scs_int Pinv[], cs **L, scs_float **D) {
+static scs_int LDLFactor(cs *A, scs_int P[], scs_int Pinv[], cs **L,
+                         scs_float **D) {
     scs_int kk, n = A->n;
     scs_int *Parent = scs_malloc(n * sizeof(scs_int));
     scs_int *Lnz = scs_malloc(n * sizeof(scs_int));
@@ -129,8 +156,34 @@ scs_int LDLFactor(cs *A, scs_int P[], scs_int Pinv[], cs **L, scs_float **D) {
     return (kk - n);
 }
 
-void LDLSolve(scs_float *x, scs_float b[], cs *L, scs_float D[], scs_int P[],
-              scs_float *bp) {
+/* numeric factorization of A into L and D, which already hold the factor of a
+ * matrix with the same pattern */
+static scs_int LDLRefactor(cs *A, cs *L, scs_float *D) {
+    scs_int kk = -1, n = A->n;
+    scs_int *Parent = scs_malloc(n * sizeof(scs_int));
+    scs_int *Lnz = scs_malloc(n * sizeof(scs_int));
+    scs_int *Flag = scs_malloc(n * sizeof(scs_int));
+    scs_int *Pattern = scs_malloc(n * sizeof(scs_int));
+    scs_float *Y = scs_malloc(n * sizeof(scs_float));
+    if (Y && Pattern && Flag && Lnz && Parent) {
+        /* the symbolic pass only rebuilds the elimination tree, L->p is
+         * unchanged */
+        LDL_symbolic(n, A->p, A->i, L->p, Parent, Lnz, Flag, SCS_NULL,
+                     SCS_NULL);
+        kk = LDL_numeric(n, A->p, A->i, A->x, L->p, Parent, Lnz, L->i, L->x,
+                         D, Y, Pattern, Flag, SCS_NULL, SCS_NULL) -
+             n;
+    }
+    scs_free(Parent);
+    scs_free(Lnz);
+    scs_free(Flag);
+    scs_free(Pattern);
+    scs_free(Y);
+    return kk;
+}
+
+static void LDLSolve(scs_float *x, scs_float b[], cs *L, scs_float D[],
+                     scs_int P[], scs_float *bp) {
     /* solves PLDL'P' x = b for x */
     scs_int n = L->n;
     if (P == SCS_NULL) {
@@ -148,56 +201,222 @@ void LDLSolve(scs_float *x, scs_float b[], cs *L, scs_float D[], scs_int P[],
     }
 }
 
-void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
-                   scs_float *y) {
+static void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
+                          scs_float *y) {
     _accumByAtrans(A->n, A->x, A->i, A->p, x, y);
+    accumByLowRankTrans(A, x, y);
 }
 
-void accumByA(const AMatrix *A, Priv *p, const scs_float *x, scs_float *y) {
+static void accumByA(const AMatrix *A, Priv *p, const scs_float *x,
+                     scs_float *y) {
     _accumByA(A->n, A->x, A->i, A->p, x, y);
+    accumByLowRank(A, x, y);
 }
 
-scs_int factorize(const AMatrix *A, const Settings *stgs, Priv *p) {
-    scs_float *info;
-    scs_int *Pinv, amd_status, ldl_status;
-    cs *C, *K = formKKT(A, stgs);
-    if (!K) {
-        return -1;
+/* LU factorization with row pivoting of the row major k by k matrix C */
+static scs_int LUFactor(scs_float *C, scs_int *piv, scs_int k) {
+    scs_int i, j, l, best;
+    scs_float wrk;
+    for (j = 0; j < k; ++j) {
+        best = j;
+        for (i = j + 1; i < k; ++i) {
+            if (ABS(C[i * k + j]) > ABS(C[best * k + j])) {
+                best = i;
+            }
+        }
+        piv[j] = best;
+        if (C[best * k + j] == 0) {
+            return -1;
+        }
+        for (l = 0; l < k; ++l) {
+            wrk = C[j * k + l];
+            C[j * k + l] = C[best * k + l];
+            C[best * k + l] = wrk;
+        }
+        for (i = j + 1; i < k; ++i) {
+            C[i * k + j] /= C[j * k + j];
+            for (l = j + 1; l < k; ++l) {
+                C[i * k + l] -= C[i * k + j] * C[j * k + l];
+            }
+        }
+    }
+    return 0;
+}
+
+static void LUSolve(const scs_float *C, const scs_int *piv, scs_int k,
+                    scs_float *x) {
+    scs_int i, j;
+    scs_float wrk;
+    for (i = 0; i < k; ++i) {
+        wrk = x[i];
+        x[i] = x[piv[i]];
+        x[piv[i]] = wrk;
+        for (j = 0; j < i; ++j) {
+            x[i] -= C[i * k + j] * x[j];
+        }
+    }
+    for (i = k - 1; i >= 0; --i) {
+        for (j = i + 1; j < k; ++j) {
+            x[i] -= C[i * k + j] * x[j];
+        }
+        x[i] /= C[i * k + i];
+    }
+}
+
+/* t = W'y for W = [V 0; 0 U] */
+static void multByWtrans(const AMatrix *A, const scs_float *y, scs_float *t) {
+    scs_int k, r = A->rank;
+    for (k = 0; k < r; ++k) {
+        t[k] = innerProd(&(A->V[k * A->n]), y, A->n);
+        t[r + k] = innerProd(&(A->U[k * A->m]), &(y[A->n]), A->m);
     }
-    amd_status = LDLInit(K, p->P, &info);
-    if (amd_status < 0)
-        return (amd_status);
+}
+
+/* with a low rank term the KKT matrix is K + W E W', K that of the sparse
+ * part, W = [V 0; 0 U] and E = [0 I; I 0] = inv(E), so by the Woodbury
+ * identity a solve is one with K less Z inv(C) W' times it, where Z = inv(K) W
+ * and C = E + W'Z; this factors C, refactored with K */
+static scs_int factorLowRank(const AMatrix *A, Priv *p) {
+    scs_int i, j, r = A->rank, k = 2 * A->rank, n_plus_m = A->n + A->m;
+    scs_float *Zj;
+    if (r <= 0) {
+        return 0;
+    }
+    if (!p->Z) {
+        p->Z = scs_malloc(n_plus_m * k * sizeof(scs_float));
+        p->C = scs_malloc(k * k * sizeof(scs_float));
+        p->piv = scs_malloc(k * sizeof(scs_int));
+        p->t = scs_malloc(k * sizeof(scs_float));
+        if (!p->Z || !p->C || !p->piv || !p->t) {
+            return -1;
+        }
+    }
+    memset(p->Z, 0, n_plus_m * k * sizeof(scs_float));
+    for (j = 0; j < r; ++j) {
+        memcpy(&(p->Z[j * n_plus_m]), &(A->V[j * A->n]),
+               A->n * sizeof(scs_float));
+        memcpy(&(p->Z[(r + j) * n_plus_m + A->n]), &(A->U[j * A->m]),
+               A->m * sizeof(scs_float));
+    }
+    for (j = 0; j < k; ++j) {
+        Zj = &(p->Z[j * n_plus_m]);
+        LDLSolve(Zj, Zj, p->L, p->D, p->P, p->bp);
+        /* column j of C */
+        multByWtrans(A, Zj, p->t);
+        for (i = 0; i < k; ++i) {
+            p->C[i * k + j] = p->t[i] + (i == j + r || j == i + r ? 1 : 0);
+        }
+    }
+    return LUFactor(p->C, p->piv, k);
+}
+
+/* orders the KKT matrix with x in its first n rows by blocks, the longer of
+ * x and y first, so the fill is at most the dense Schur complement of the
+ * shorter one */
+static void blockOrder(scs_int P[], scs_int n, scs_int n_plus_m) {
+    scs_int i, m = n_plus_m - n;
+    for (i = 0; i < n_plus_m; ++i) {
+        P[i] = n <= m ? (i + n) % n_plus_m : i;
+    }
+}
+
+/* orders and factors K (which is freed) into p->P, p->L and p->D, the first
+ * n rows of K being x */
+static scs_int factorizeKKT(cs *K, scs_int n, const Settings *stgs, Priv *p) {
+    scs_float *info = SCS_NULL;
+    scs_int *Pinv, amd_status, ldl_status, n_plus_m = K->n;
+    cs *C;
+    if (n_plus_m <= BLOCK_ORDER_MAX_DIM) {
+        /* AMD would be most of the setup time */
+        blockOrder(p->P, n, n_plus_m);
+    } else {
+        amd_status = LDLInit(K, p->P, &info);
+        if (amd_status < 0) {
+            cs_spfree(K);
+            scs_free(info);
+            return (amd_status);
+        }
 #if EXTRAVERBOSE > 0
-    if (stgs->verbose) {
-        scs_printf("Matrix factorization info:\n");
+        if (stgs->verbose) {
+            scs_printf("Matrix factorization info:\n");
 #ifdef DLONG
-        amd_l_info(info);
+            amd_l_info(info);
 #else
-        amd_info(info);
+            amd_info(info);
 #endif
-    }
+        }
 #endif
-    Pinv = cs_pinv(p->P, A->n + A->m);
+    }
+    Pinv = cs_pinv(p->P, n_plus_m);
     C = cs_symperm(K, Pinv, 1);
     ldl_status = LDLFactor(C, SCS_NULL, SCS_NULL, &p->L, &p->D);
     cs_spfree(C);
     cs_spfree(K);
     scs_free(Pinv);
-    scs_free(info);
+    if (info) {
+        scs_free(info);
+    }
     return (ldl_status);
 }
 
-Priv *initPriv(const AMatrix *A, const Settings *stgs) {
+static scs_int factorize(const AMatrix *A, const Settings *stgs, Priv *p) {
+    cs *K = formKKT(A, stgs);
+    if (!K) {
+        return -1;
+    }
+    return factorizeKKT(K, A->n, stgs, p);
+}
+
+static scs_int updateLinSys(const AMatrix *A, const Settings *stgs, Priv *p) {
+    /* numeric refactorization, the ordering in p->P is kept */
+    scs_int *Pinv, ldl_status = -1;
+    cs *C = SCS_NULL, *K = formKKT(A, stgs);
+    if (!K) {
+        return -1;
+    }
+    Pinv = cs_pinv(p->P, K->n);
+    if (Pinv) {
+        C = cs_symperm(K, Pinv, 1);
+    }
+    if (C) {
+        ldl_status = LDLRefactor(C, p->L, p->D);
+    }
+    cs_spfree(C);
+    cs_spfree(K);
+    scs_free(Pinv);
+    if (ldl_status < 0) {
+        return ldl_status;
+    }
+    return factorLowRank(A, p);
+}
+
+static Priv *allocPriv(scs_int n_plus_m) {
     Priv *p = scs_calloc(1, sizeof(Priv));
-    scs_int n_plus_m = A->n + A->m;
+    if (!p) {
+        return SCS_NULL;
+    }
     p->P = scs_malloc(sizeof(scs_int) * n_plus_m);
     p->L = scs_malloc(sizeof(cs));
     p->bp = scs_malloc(n_plus_m * sizeof(scs_float));
+    if (!p->P || !p->L || !p->bp) {
+        freePriv(p);
+        return SCS_NULL;
+    }
     p->L->m = n_plus_m;
     p->L->n = n_plus_m;
     p->L->nz = -1;
+    p->L->p = SCS_NULL;
+    p->L->i = SCS_NULL;
+    p->L->x = SCS_NULL;
+    return p;
+}
 
-    if (factorize(A, stgs, p) < 0) {
+static Priv *initPriv(const AMatrix *A, const Settings *stgs) {
+    Priv *p = allocPriv(A->n + A->m);
+    if (!p) {
+        return SCS_NULL;
+    }
+    if (factorize(A, stgs, p) < 0 || factorLowRank(A, p) < 0) {
         freePriv(p);
         return SCS_NULL;
     }
@@ -205,16 +424,134 @@ Priv *initPriv(const AMatrix *A, const Settings *stgs) {
     return p;
 }
 
-scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
-                    scs_float *b, const scs_float *s, scs_int iter) {
+static scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                           scs_float *b, const scs_float *s, scs_int iter) {
     /* returns solution to linear system */
     /* Ax = b with solution stored in b */
+    scs_int i;
     timer linsysTimer;
     tic(&linsysTimer);
     LDLSolve(b, b, p->L, p->D, p->P, p->bp);
+    if (A->rank > 0) {
+        multByWtrans(A, b, p->t);
+        LUSolve(p->C, p->piv, 2 * A->rank, p->t);
+        for (i = 0; i < 2 * A->rank; ++i) {
+            addScaledArray(b, &(p->Z[i * (A->n + A->m)]), A->n + A->m,
+                           -p->t[i]);
+        }
+    }
     p->totalSolveTime += tocq(&linsysTimer);
 #if EXTRAVERBOSE > 0
     scs_printf("linsys solve time: %1.2es\n", tocq(&linsysTimer) / 1e3);
 #endif
     return 0;
 }
+
+/* upper triangular part of [delta I, A_a'; A_a, -delta I], see assembleKKT */
+static cs *formPolishKKT(const AMatrix *A, const scs_int *active,
+                         scs_float delta) {
+    return assembleKKT(A, active, delta, -delta);
+}
+
+/* r = b - [0 A_a'; A_a 0] z on the active rows, r = 0 on the others */
+static void polishResid(const AMatrix *A, const scs_int *active,
+                        const scs_float *b, const scs_float *z, scs_float *r,
+                        scs_float *tmp) {
+    scs_int i, n = A->n, m = A->m;
+    memcpy(r, b, (n + m) * sizeof(scs_float));
+    memset(tmp, 0, m * sizeof(scs_float));
+    _accumByA(n, A->x, A->i, A->p, z, tmp);
+    for (i = 0; i < m; ++i) {
+        r[n + i] = active[i] ? r[n + i] - tmp[i] : 0;
+        tmp[i] = active[i] ? -z[n + i] : 0;
+    }
+    _accumByAtrans(n, A->x, A->i, A->p, tmp, r);
+}
+
+static scs_int solvePolishSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                              const scs_int *active, const scs_float *b,
+                              scs_float *x) {
+    scs_int i, n_plus_m = A->n + A->m;
+    scs_float *r, *tmp;
+    cs *K;
+    Priv *q;
+    timer linsysTimer;
+    if (A->rank > 0) {
+        /* the active rows of the low rank term are not handled */
+        return -1;
+    }
+    tic(&linsysTimer);
+    K = formPolishKKT(A, active, POLISH_DELTA);
+    q = allocPriv(n_plus_m);
+    if (!K || !q) {
+        if (K)
+            cs_spfree(K);
+        freePriv(q);
+        return -1;
+    }
+    if (factorizeKKT(K, A->n, stgs, q) < 0) {
+        freePriv(q);
+        return -1;
+    }
+    r = scs_malloc((n_plus_m + A->m) * sizeof(scs_float));
+    if (!r) {
+        freePriv(q);
+        return -1;
+    }
+    tmp = &(r[n_plus_m]);
+    for (i = 0; i < A->m; ++i) {
+        if (!active[i]) {
+            x[A->n + i] = 0;
+        }
+    }
+    /* refinement from the guess against the unregularized system, the
+     * corrections are small so x stays near the guess when it is singular */
+    for (i = 0; i <= POLISH_REFINE_ITERS; ++i) {
+        polishResid(A, active, b, x, r, tmp);
+        LDLSolve(r, r, q->L, q->D, q->P, q->bp);
+        addScaledArray(x, r, n_plus_m, 1.0);
+    }
+    scs_free(r);
+    freePriv(q);
+    p->totalSolveTime += tocq(&linsysTimer);
+    return 0;
+}
+
+/* factoring costs a divide per column and two flops per multiply-subtract, a
+ * solve two flops per entry of L on each of the two triangular solves and a
+ * divide per row, the counts coming from the AMD ordering of the KKT matrix;
+ * a low rank term adds 2 rank solves to the setup and products with W and Z
+ * to each solve */
+static scs_float estimateCost(const AMatrix *A, const Settings *stgs,
+                              scs_int iters) {
+    scs_float cost = -1, *info = SCS_NULL;
+    scs_int *P = scs_malloc((A->n + A->m) * sizeof(scs_int));
+    cs *K = formKKT(A, stgs);
+    if (K && P && LDLInit(K, P, &info) >= 0) {
+        cost = info[AMD_NDIV] + 2 * info[AMD_NMULTSUBS_LDL] +
+               (2 * A->rank + iters) * (4 * info[AMD_LNZ] + K->n) +
+               iters * 6 * A->rank * K->n;
+    }
+    if (K) {
+        cs_spfree(K);
+    }
+    if (info) {
+        scs_free(info);
+    }
+    if (P) {
+        scs_free(P);
+    }
+    return cost;
+}
+
+const LinSys directLinSys = {LINSYS_DIRECT, initPriv, solveLinSys, updateLinSys,
+                             solvePolishSys, freePriv, accumByAtrans, accumByA,
+                             getLinSysMethod, getLinSysSummary, estimateCost};
+
+#ifndef ALL_LINSYS
+const LinSys *selectLinSys(const AMatrix *A, const Settings *stgs) {
+    return stgs->linsys == LINSYS_AUTO || stgs->linsys == LINSYS_DIRECT
+               ? &directLinSys
+               : SCS_NULL;
+}
+#endif
@@ -13,6 +13,11 @@ struct PRIVATE_DATA {
     scs_float *D;  /* diagonal matrix of factorization */
     scs_int *P;    /* permutation of KKT matrix for factorization */
     scs_float *bp; /* workspace memory for solves */
+    /* low rank term of A, see factorLowRank */
+    scs_float *Z;  /* inv(K) W, size: (n + m) * 2 rank */
+    scs_float *C;  /* LU factors of the capacitance matrix, 2 rank square */
+    scs_int *piv;  /* row pivots of C */
+    scs_float *t;  /* workspace, size: 2 rank */
     /* reporting */
     scs_float totalSolveTime;
 };
@@ -49,7 +49,7 @@ extern "C" {
     A'(n x m)       A  (m x n)      Agt     accumByAGpu
 */
 
-void accumByAtransGpu(const Priv *p, const scs_float *x, scs_float *y) {
+static void accumByAtransGpu(const Priv *p, const scs_float *x, scs_float *y) {
     /* y += A'*x
        x and y MUST be on GPU already
     */
@@ -60,7 +60,7 @@ void accumByAtransGpu(const Priv *p, const scs_float *x, scs_float *y) {
                     &onef, y);
 }
 
-void accumByAGpu(const Priv *p, const scs_float *x, scs_float *y) {
+static void accumByAGpu(const Priv *p, const scs_float *x, scs_float *y) {
     /* y += A*x
        x and y MUST be on GPU already
      */
@@ -72,8 +72,8 @@ void accumByAGpu(const Priv *p, const scs_float *x, scs_float *y) {
 }
 
 /* do not use within pcg, reuses memory */
-void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
-                   scs_float *y) {
+static void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
+                          scs_float *y) {
     scs_float *v_m = p->tmp_m;
     scs_float *v_n = p->r;
     cudaMemcpy(v_m, x, A->m * sizeof(scs_float), cudaMemcpyHostToDevice);
@@ -83,7 +83,8 @@ void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
 }
 
 /* do not use within pcg, reuses memory */
-void accumByA(const AMatrix *A, Priv *p, const scs_float *x, scs_float *y) {
+static void accumByA(const AMatrix *A, Priv *p, const scs_float *x,
+                     scs_float *y) {
     scs_float *v_m = p->tmp_m;
     scs_float *v_n = p->r;
     cudaMemcpy(v_n, x, A->n * sizeof(scs_float), cudaMemcpyHostToDevice);
@@ -92,14 +93,14 @@ void accumByA(const AMatrix *A, Priv *p, const scs_float *x, scs_float *y) {
     cudaMemcpy(y, v_m, A->m * sizeof(scs_float), cudaMemcpyDeviceToHost);
 }
 
-char *getLinSysMethod(const AMatrix *A, const Settings *s) {
+static char *getLinSysMethod(const AMatrix *A, const Settings *s) {
     char *str = (char *)scs_malloc(sizeof(char) * 128);
     sprintf(str, "sparse-indirect GPU, nnz in A = %li, CG tol ~ 1/iter^(%2.2f)",
             (long)A->p[A->n], s->cg_rate);
     return str;
 }
 
-char *getLinSysSummary(Priv *p, const Info *info) {
+static char *getLinSysSummary(Priv *p, const Info *info) {
     char *str = (char *)scs_malloc(sizeof(char) * 128);
     sprintf(str,
             "\tLin-sys: avg # CG iterations: %2.2f, avg solve time: %1.2es\n",
@@ -110,7 +111,7 @@ char *getLinSysSummary(Priv *p, const Info *info) {
     return str;
 }
 
-void cudaFreeAMatrix(AMatrix *A) {
+static void cudaFreeAMatrix(AMatrix *A) {
     if (A->x)
         cudaFree(A->x);
     if (A->i)
@@ -119,7 +120,7 @@ void cudaFreeAMatrix(AMatrix *A) {
         cudaFree(A->p);
 }
 
-void freePriv(Priv *p) {
+static void freePriv(Priv *p) {
     if (p) {
         if (p->p)
             cudaFree(p->p);
@@ -163,7 +164,7 @@ static void matVec(const AMatrix *A, const Settings *s, Priv *p,
 }
 
 /* M = inv ( diag ( RHO_X * I + A'A ) ) */
-void getPreconditioner(const AMatrix *A, const Settings *stgs, Priv *p) {
+static void getPreconditioner(const AMatrix *A, const Settings *stgs, Priv *p) {
     scs_int i;
     scs_float *M = (scs_float *)scs_malloc(A->n * sizeof(scs_float));
 
@@ -184,9 +185,14 @@ void getPreconditioner(const AMatrix *A, const Settings *stgs, Priv *p) {
 #endif
 }
 
-Priv *initPriv(const AMatrix *A, const Settings *stgs) {
+static Priv *initPriv(const AMatrix *A, const Settings *stgs) {
     cudaError_t err;
-    Priv *p = (Priv *)scs_calloc(1, sizeof(Priv));
+    Priv *p;
+    if (A->rank > 0) {
+        scs_printf("the GPU solver does not support a low rank term in A\n");
+        return SCS_NULL;
+    }
+    p = (Priv *)scs_calloc(1, sizeof(Priv));
     p->Annz = A->p[A->n];
     p->cublasHandle = 0;
     p->cusparseHandle = 0;
@@ -340,16 +346,17 @@ static scs_int pcg(const AMatrix *A, const Settings *stgs, Priv *pr,
 }
 
 #ifdef TEST_GPU_MAT_MUL
-void accumByAtransHost(const AMatrix *A, Priv *p, const scs_float *x,
-                       scs_float *y) {
+static void accumByAtransHost(const AMatrix *A, Priv *p, const scs_float *x,
+                              scs_float *y) {
     _accumByAtrans(A->n, A->x, A->i, A->p, x, y);
 }
 
-void accumByAHost(const AMatrix *A, Priv *p, const scs_float *x, scs_float *y) {
+static void accumByAHost(const AMatrix *A, Priv *p, const scs_float *x,
+                         scs_float *y) {
     _accumByA(A->n, A->x, A->i, A->p, x, y);
 }
 
-void testGpuMatMul(const AMatrix *A, Priv *p, scs_float *b) {
+static void testGpuMatMul(const AMatrix *A, Priv *p, scs_float *b) {
     /* test to see if matrix multiplication codes agree */
     scs_float t[A->n + A->m], u[A->n + A->m], *bg;
     cudaMalloc((void **)&bg, (A->n + A->m) * sizeof(scs_float));
@@ -374,8 +381,8 @@ void testGpuMatMul(const AMatrix *A, Priv *p, scs_float *b) {
 }
 #endif
 
-scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
-                    scs_float *b, const scs_float *s, scs_int iter) {
+static scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                           scs_float *b, const scs_float *s, scs_int iter) {
     scs_int cgIts;
     timer linsysTimer;
     scs_float *bg = p->bg;
@@ -415,6 +422,47 @@ scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
     return 0;
 }
 
+static scs_int updateLinSys(const AMatrix *A, const Settings *stgs, Priv *p) {
+    cudaError_t err;
+    AMatrix *Ag = p->Ag, *Agt = p->Agt;
+    cudaMemcpy(Ag->x, A->x, (A->p[A->n]) * sizeof(scs_float),
+               cudaMemcpyHostToDevice);
+    CUSPARSE(csr2csc)(p->cusparseHandle, A->n, A->m, A->p[A->n], Ag->x, Ag->p,
+                      Ag->i, Agt->x, Agt->i, Agt->p, CUSPARSE_ACTION_NUMERIC,
+                      CUSPARSE_INDEX_BASE_ZERO);
+    getPreconditioner(A, stgs, p);
+    err = cudaGetLastError();
+    if (err != cudaSuccess) {
+        printf("%s:%d:%s\nERROR_CUDA: %s\n", __FILE__, __LINE__, __func__,
+               cudaGetErrorString(err));
+        return -1;
+    }
+    return 0;
+}
+
+/* polishing needs a factorization, only the direct solver supports it */
+static scs_int solvePolishSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                              const scs_int *active, const scs_float *b,
+                              scs_float *x) {
+    return -1;
+}
+
+/* the GPU backend is the only one in its library, so the cost is not used */
+static scs_float estimateCost(const AMatrix *A, const Settings *stgs,
+                              scs_int iters) {
+    return -1;
+}
+
+const LinSys gpuLinSys = {LINSYS_GPU, initPriv, solveLinSys, updateLinSys,
+                          solvePolishSys, freePriv, accumByAtrans, accumByA,
+                          getLinSysMethod, getLinSysSummary, estimateCost};
+
+const LinSys *selectLinSys(const AMatrix *A, const Settings *stgs) {
+    return stgs->linsys == LINSYS_AUTO || stgs->linsys == LINSYS_GPU
+               ? &gpuLinSys
+               : SCS_NULL;
+}
+
 #ifdef __cplusplus
 }
 #endif
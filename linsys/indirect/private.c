@@ -2,15 +2,17 @@
 
 #define CG_BEST_TOL 1e-9
 #define CG_MIN_TOL 1e-1
+/* typical number of CG steps per solve once warm started, for estimateCost */
+#define CG_EST_ITERS 10
 
-char *getLinSysMethod(const AMatrix *A, const Settings *s) {
+static char *getLinSysMethod(const AMatrix *A, const Settings *s) {
     char *str = scs_malloc(sizeof(char) * 128);
     sprintf(str, "sparse-indirect, nnz in A = %li, CG tol ~ 1/iter^(%2.2f)",
             (long)A->p[A->n], s->cg_rate);
     return str;
 }
 
-char *getLinSysSummary(Priv *p, const Info *info) {
+static char *getLinSysSummary(Priv *p, const Info *info) {
     char *str = scs_malloc(sizeof(char) * 128);
     sprintf(str,
             "\tLin-sys: avg # CG iterations: %2.2f, avg solve time: %1.2es\n",
@@ -22,7 +24,7 @@ char *getLinSysSummary(Priv *p, const Info *info) {
 }
 
 /* M = inv ( diag ( RHO_X * I + A'A ) ) */
-void getPreconditioner(const AMatrix *A, const Settings *stgs, Priv *p) {
+static void getPreconditioner(const AMatrix *A, const Settings *stgs, Priv *p) {
     scs_int i;
     scs_float *M = p->M;
 
@@ -30,9 +32,9 @@ void getPreconditioner(const AMatrix *A, const Settings *stgs, Priv *p) {
     scs_printf("getting pre-conditioner\n");
 #endif
 
+    colNormsSqA(A, M);
     for (i = 0; i < A->n; ++i) {
-        M[i] = 1 / (stgs->rho_x +
-                    calcNormSq(&(A->x[A->p[i]]), A->p[i + 1] - A->p[i]));
+        M[i] = 1 / (stgs->rho_x + M[i]);
         /* M[i] = 1; */
     }
 
@@ -82,7 +84,7 @@ static void transpose(const AMatrix *A, Priv *p) {
 #endif
 }
 
-void freePriv(Priv *p) {
+static void freePriv(Priv *p) {
     if (p) {
         if (p->p)
             scs_free(p->p);
@@ -110,6 +112,18 @@ void freePriv(Priv *p) {
     }
 }
 
+static void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
+                          scs_float *y) {
+    _accumByAtrans(A->n, A->x, A->i, A->p, x, y);
+    accumByLowRankTrans(A, x, y);
+}
+
+static void accumByA(const AMatrix *A, Priv *p, const scs_float *x,
+                     scs_float *y) {
+    _accumByAtrans(p->At->n, p->At->x, p->At->i, p->At->p, x, y);
+    accumByLowRank(A, x, y);
+}
+
 /*y = (RHO_X * I + A'A)x */
 static void matVec(const AMatrix *A, const Settings *s, Priv *p,
                    const scs_float *x, scs_float *y) {
@@ -121,15 +135,6 @@ static void matVec(const AMatrix *A, const Settings *s, Priv *p,
     addScaledArray(y, x, A->n, s->rho_x);
 }
 
-void accumByAtrans(const AMatrix *A, Priv *p, const scs_float *x,
-                   scs_float *y) {
-    _accumByAtrans(A->n, A->x, A->i, A->p, x, y);
-}
-
-void accumByA(const AMatrix *A, Priv *p, const scs_float *x, scs_float *y) {
-    _accumByAtrans(p->At->n, p->At->x, p->At->i, p->At->p, x, y);
-}
-
 static void applyPreConditioner(scs_float *M, scs_float *z, scs_float *r,
                                 scs_int n, scs_float *ipzr) {
     scs_int i;
@@ -140,7 +145,7 @@ static void applyPreConditioner(scs_float *M, scs_float *z, scs_float *r,
     }
 }
 
-Priv *initPriv(const AMatrix *A, const Settings *stgs) {
+static Priv *initPriv(const AMatrix *A, const Settings *stgs) {
     Priv *p = scs_calloc(1, sizeof(Priv));
     p->p = scs_malloc((A->n) * sizeof(scs_float));
     p->r = scs_malloc((A->n) * sizeof(scs_float));
@@ -148,7 +153,7 @@ Priv *initPriv(const AMatrix *A, const Settings *stgs) {
     p->tmp = scs_malloc((A->m) * sizeof(scs_float));
 
     /* memory for A transpose */
-    p->At = scs_malloc(sizeof(AMatrix));
+    p->At = scs_calloc(1, sizeof(AMatrix));
     p->At->m = A->n;
     p->At->n = A->m;
     p->At->i = scs_malloc((A->p[A->n]) * sizeof(scs_int));
@@ -223,8 +228,8 @@ static scs_int pcg(const AMatrix *A, const Settings *stgs, Priv *pr,
     return i;
 }
 
-scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
-                    scs_float *b, const scs_float *s, scs_int iter) {
+static scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                           scs_float *b, const scs_float *s, scs_int iter) {
     scs_int cgIts;
     timer linsysTimer;
     scs_float cgTol =
@@ -251,3 +256,40 @@ scs_int solveLinSys(const AMatrix *A, const Settings *stgs, Priv *p,
 #endif
     return 0;
 }
+
+static scs_int updateLinSys(const AMatrix *A, const Settings *stgs, Priv *p) {
+    transpose(A, p);
+    getPreconditioner(A, stgs, p);
+    return 0;
+}
+
+/* polishing needs a factorization, only the direct solver supports it */
+static scs_int solvePolishSys(const AMatrix *A, const Settings *stgs, Priv *p,
+                              const scs_int *active, const scs_float *b,
+                              scs_float *x) {
+    return -1;
+}
+
+/* a solve multiplies by A' and A, then each CG step by A and A' and does a
+ * handful of vector operations, the setup transposes A and forms the
+ * preconditioner */
+static scs_float estimateCost(const AMatrix *A, const Settings *stgs,
+                              scs_int iters) {
+    /* a multiply by A and by A', counting the low rank term */
+    scs_float mult = 2 * A->p[A->n] + 4 * (scs_float)A->rank * (A->n + A->m);
+    return 3 * A->p[A->n] +
+           iters * (2 * mult + CG_EST_ITERS * (2 * mult + 10 * (scs_float)A->n));
+}
+
+const LinSys indirectLinSys = {LINSYS_INDIRECT, initPriv, solveLinSys,
+                               updateLinSys, solvePolishSys, freePriv,
+                               accumByAtrans, accumByA, getLinSysMethod,
+                               getLinSysSummary, estimateCost};
+
+#ifndef ALL_LINSYS
+const LinSys *selectLinSys(const AMatrix *A, const Settings *stgs) {
+    return stgs->linsys == LINSYS_AUTO || stgs->linsys == LINSYS_INDIRECT
+               ? &indirectLinSys
+               : SCS_NULL;
+}
+#endif
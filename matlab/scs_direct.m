@@ -33,7 +33,13 @@ function [x, y, s, info] = scs_direct(data, cone, params)
 %   verbose     : verbosity level (0 or 1)
 %   normalize   : heuristic data rescaling (0 or 1, off or on)
 %   scale       : rescales data up by this factor (only used if normalize=1)
+%   polish      : polish the solution after convergence (0 or 1, direct only)
+%   adapt_scale : max updates of scale from the residual balance (default 0)
+%   adapt_alpha : adapt alpha from the fixed point residual (0 or 1)
+%   stall_stop  : stop as inaccurate when the residuals stall (0 or 1)
 %
 % to warm-start the solver add guesses for (x, y, s) to the data struct
 %
+% to set up once and solve for many b and c see scs_init
+%
 error ('scs_direct mexFunction not found') ;
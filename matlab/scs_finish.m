@@ -0,0 +1,3 @@
+function scs_finish( work )
+% frees the workspace of scs_init
+feval(work.solver, 'finish', work.handle);
@@ -0,0 +1,19 @@
+function work = scs_init( data, K, pars )
+% sets up data and cone once (A normalized and, for the direct solver,
+% factored) for many calls of scs_solve with new b, c or warm starts; takes
+% the arguments of scs, the settings fixed at this call
+%
+% the workspace lives in the mex function until scs_finish(work), or until
+% matlab exits
+if nargin < 3
+    pars = [];
+end
+
+if (isfield(pars,'use_indirect') && ~pars.use_indirect)
+    work.solver = 'scs_direct';
+elseif (isfield(pars,'gpu') && pars.gpu)
+    work.solver = 'scs_gpu';
+else
+    work.solver = 'scs_indirect';
+end
+work.handle = feval(work.solver, 'init', data, K, pars);
@@ -5,8 +5,37 @@
 #include "linAlg.h"
 #include "linsys/amatrix.h"
 
+/* a workspace set up by 'init', solved by 'solve' and freed by 'finish',
+ * which with the data it was set up with is persistent memory */
+typedef struct MexWork {
+    double id;
+    Data *d;
+    Cone *k;
+    Work *w;
+    scs_float setupTime;
+    struct MexWork *next;
+} MexWork;
+
+static MexWork *works = SCS_NULL; /* the live workspaces */
+static double lastId = 0;
+static int persist = 0; /* set while allocations must outlive the call */
+
 void freeMex(Data *d, Cone *k);
 
+void *scsMexMalloc(size_t size) {
+    void *p = mxMalloc(size);
+    if (persist && p)
+        mexMakeMemoryPersistent(p);
+    return p;
+}
+
+void *scsMexCalloc(size_t num, size_t size) {
+    void *p = mxCalloc(num, size);
+    if (persist && p)
+        mexMakeMemoryPersistent(p);
+    return p;
+}
+
 scs_int parseWarmStart(const mxArray *p_mex, scs_float **p, scs_int l) {
     *p = scs_calloc(l,
                     sizeof(scs_float)); /* this allocates memory used for Sol */
@@ -68,98 +97,91 @@ void setOutputField(mxArray **pout, scs_float *out, scs_int len) {
     mxSetN(*pout, 1);
 }
 
-void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
-    /* matlab usage: [x,y,s,info] = scs(data,cone,settings); */
-    scs_int i, ns, status;
-    Data *d;
-    Cone *k;
-    Sol sol = {0};
-    Info info;
-    AMatrix *A;
-
-    const mxArray *data;
-    const mxArray *A_mex;
-    const mxArray *b_mex;
-    const mxArray *c_mex;
-
-    const mxArray *kf;
-    const mxArray *kl;
-    const mxArray *kq;
-    const mxArray *ks;
-    const mxArray *kep;
-    const mxArray *ked;
-    const mxArray *kp;
-    const double *q_mex;
-    const double *s_mex;
-    const double *p_mex;
-    const size_t *q_dims;
-    const size_t *s_dims;
-    const size_t *p_dims;
-
-    const mxArray *cone;
-    const mxArray *settings;
-
+void setInfo(mxArray **pout, const Info *info) {
     const mwSize one[1] = {1};
-    const int numInfoFields = 11;
+    const int numInfoFields = 12;
     const char *infoFields[] = {"iter",   "status",    "pobj",      "dobj",
                                 "resPri", "resDual",   "resInfeas", "resUnbdd",
-                                "relGap", "setupTime", "solveTime"};
+                                "relGap", "setupTime", "solveTime", "alpha"};
     mxArray *tmp;
-#if EXTRAVERBOSE > 0
-    scs_printf("SIZE OF mwSize = %i\n", (int)sizeof(mwSize));
-    scs_printf("SIZE OF mwIndex = %i\n", (int)sizeof(mwIndex));
-#endif
 
-    if (nrhs != 3) {
-        mexErrMsgTxt("Three arguments are required in this order: data struct, "
-                     "cone struct, settings struct");
-    }
-    if (nlhs > 4) {
-        mexErrMsgTxt("scs returns up to 4 output arguments only.");
-    }
-    d = mxMalloc(sizeof(Data));
-    d->stgs = mxMalloc(sizeof(Settings));
-    k = mxMalloc(sizeof(Cone));
-    data = prhs[0];
+    *pout = mxCreateStructArray(1, one, numInfoFields, infoFields);
+
+    mxSetField(*pout, 0, "status", mxCreateString(info->status));
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "iter", tmp);
+    *mxGetPr(tmp) = (scs_float)info->iter;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "pobj", tmp);
+    *mxGetPr(tmp) = info->pobj;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "dobj", tmp);
+    *mxGetPr(tmp) = info->dobj;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "resPri", tmp);
+    *mxGetPr(tmp) = info->resPri;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "resDual", tmp);
+    *mxGetPr(tmp) = info->resDual;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "resInfeas", tmp);
+    *mxGetPr(tmp) = info->resInfeas;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "resUnbdd", tmp);
+    *mxGetPr(tmp) = info->resUnbdd;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "relGap", tmp);
+    *mxGetPr(tmp) = info->relGap;
+
+    /*info.time is millisecs - return value in secs */
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "setupTime", tmp);
+    *mxGetPr(tmp) = info->setupTime;
+
+    /*info.time is millisecs - return value in secs */
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "solveTime", tmp);
+    *mxGetPr(tmp) = info->solveTime;
+
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(*pout, 0, "alpha", tmp);
+    *mxGetPr(tmp) = info->alpha;
+}
+
+/* points d at b, c and A of the data struct, returns an error message or
+ * SCS_NULL */
+const char *parseData(const mxArray *data, Data *d) {
+    AMatrix *A;
+    const mxArray *A_mex = mxGetField(data, 0, "A");
+    const mxArray *b_mex = mxGetField(data, 0, "b");
+    const mxArray *c_mex = mxGetField(data, 0, "c");
 
-    A_mex = (mxArray *)mxGetField(data, 0, "A");
     if (A_mex == SCS_NULL) {
-        scs_free(d);
-        scs_free(k);
-        mexErrMsgTxt("Data struct must contain a `A` entry.");
+        return "Data struct must contain a `A` entry.";
     }
     if (!mxIsSparse(A_mex)) {
-        scs_free(d);
-        scs_free(k);
-        mexErrMsgTxt(
-            "Input matrix A must be in sparse format (pass in sparse(A))");
+        return "Input matrix A must be in sparse format (pass in sparse(A))";
     }
-    b_mex = (mxArray *)mxGetField(data, 0, "b");
     if (b_mex == SCS_NULL) {
-        scs_free(d);
-        scs_free(k);
-        mexErrMsgTxt("Data struct must contain a `b` entry.");
+        return "Data struct must contain a `b` entry.";
     }
     if (mxIsSparse(b_mex)) {
-        scs_free(d);
-        scs_free(k);
-        mexErrMsgTxt(
-            "Input vector b must be in dense format (pass in full(b))");
+        return "Input vector b must be in dense format (pass in full(b))";
     }
-    c_mex = (mxArray *)mxGetField(data, 0, "c");
     if (c_mex == SCS_NULL) {
-        scs_free(d);
-        scs_free(k);
-        mexErrMsgTxt("Data struct must contain a `c` entry.");
+        return "Data struct must contain a `c` entry.";
     }
     if (mxIsSparse(c_mex)) {
-        scs_free(d);
-        scs_free(k);
-        mexErrMsgTxt(
-            "Input vector c must be in dense format (pass in full(c))");
+        return "Input vector c must be in dense format (pass in full(c))";
     }
-    cone = prhs[1];
-    settings = prhs[2];
     d->n = (scs_int) * (mxGetDimensions(c_mex));
     d->m = (scs_int) * (mxGetDimensions(b_mex));
 #if FLOAT > 0
@@ -169,42 +191,108 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     d->b = (scs_float *)mxGetPr(b_mex);
     d->c = (scs_float *)mxGetPr(c_mex);
 #endif
-    setDefaultSettings(d);
 
-    /* settings */
+    A = scs_calloc(1, sizeof(AMatrix));
+    A->n = d->n;
+    A->m = d->m;
+/* TODO:
+ * these return (mwIndex *), equivalent to (size_t *)
+ * casting as (scs_int *), when scs_int = long seems to work
+ * although maybe not on all machines:
+ *
+ * If scs_int is not long, then we explictly cast the entire
+ * array to get the correct width
+ */
+#if DLONG > 0
+    A->p = (scs_int *)mxGetJc(A_mex);
+    A->i = (scs_int *)mxGetIr(A_mex);
+#else
+    A->p = castToScsIntArr(mxGetJc(A_mex), A->n + 1);
+    A->i = castToScsIntArr(mxGetIr(A_mex), A->p[A->n]);
+#endif
+#if FLOAT > 0
+    A->x = castToScsFloatArr(mxGetPr(A_mex), A->p[A->n]);
+#else
+    A->x = (scs_float *)mxGetPr(A_mex);
+#endif
+    d->A = A;
+    return SCS_NULL;
+}
+
+void parseSettings(const mxArray *settings, Settings *stgs) {
+    mxArray *tmp;
+
     tmp = mxGetField(settings, 0, "alpha");
     if (tmp != SCS_NULL)
-        d->stgs->alpha = (scs_float)*mxGetPr(tmp);
+        stgs->alpha = (scs_float)*mxGetPr(tmp);
 
     tmp = mxGetField(settings, 0, "rho_x");
     if (tmp != SCS_NULL)
-        d->stgs->rho_x = (scs_float)*mxGetPr(tmp);
+        stgs->rho_x = (scs_float)*mxGetPr(tmp);
 
     tmp = mxGetField(settings, 0, "max_iters");
     if (tmp != SCS_NULL)
-        d->stgs->max_iters = (scs_int)*mxGetPr(tmp);
+        stgs->max_iters = (scs_int)*mxGetPr(tmp);
 
     tmp = mxGetField(settings, 0, "scale");
     if (tmp != SCS_NULL)
-        d->stgs->scale = (scs_float)*mxGetPr(tmp);
+        stgs->scale = (scs_float)*mxGetPr(tmp);
 
     tmp = mxGetField(settings, 0, "eps");
     if (tmp != SCS_NULL)
-        d->stgs->eps = (scs_float)*mxGetPr(tmp);
+        stgs->eps = (scs_float)*mxGetPr(tmp);
 
     tmp = mxGetField(settings, 0, "cg_rate");
     if (tmp != SCS_NULL)
-        d->stgs->cg_rate = (scs_float)*mxGetPr(tmp);
+        stgs->cg_rate = (scs_float)*mxGetPr(tmp);
 
     tmp = mxGetField(settings, 0, "verbose");
     if (tmp != SCS_NULL)
-        d->stgs->verbose = (scs_int)*mxGetPr(tmp);
+        stgs->verbose = (scs_int)*mxGetPr(tmp);
 
     tmp = mxGetField(settings, 0, "normalize");
     if (tmp != SCS_NULL)
-        d->stgs->normalize = (scs_int)*mxGetPr(tmp);
+        stgs->normalize = (scs_int)*mxGetPr(tmp);
+
+    tmp = mxGetField(settings, 0, "polish");
+    if (tmp != SCS_NULL)
+        stgs->polish = (scs_int)*mxGetPr(tmp);
+
+    tmp = mxGetField(settings, 0, "adapt_scale");
+    if (tmp != SCS_NULL)
+        stgs->adapt_scale = (scs_int)*mxGetPr(tmp);
+
+    tmp = mxGetField(settings, 0, "adapt_alpha");
+    if (tmp != SCS_NULL)
+        stgs->adapt_alpha = (scs_int)*mxGetPr(tmp);
+
+    tmp = mxGetField(settings, 0, "stall_stop");
+    if (tmp != SCS_NULL)
+        stgs->stall_stop = (scs_int)*mxGetPr(tmp);
+}
+
+/* k must be zeroed, returns an error message or SCS_NULL */
+const char *parseCone(const mxArray *cone, Cone *k) {
+    scs_int i, ns;
+    const mxArray *kf;
+    const mxArray *kl;
+    const mxArray *kbl;
+    const mxArray *kbu;
+    const mxArray *kq;
+    const mxArray *kr;
+    const mxArray *ks;
+    const mxArray *kep;
+    const mxArray *ked;
+    const mxArray *kp;
+    const double *q_mex;
+    const double *r_mex;
+    const double *s_mex;
+    const double *p_mex;
+    const size_t *q_dims;
+    const size_t *r_dims;
+    const size_t *s_dims;
+    const size_t *p_dims;
 
-    /* cones */
     kf = mxGetField(cone, 0, "f");
     if (kf && !mxIsEmpty(kf))
         k->f = (scs_int)*mxGetPr(kf);
@@ -217,6 +305,26 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     else
         k->l = 0;
 
+    kbl = mxGetField(cone, 0, "bl");
+    kbu = mxGetField(cone, 0, "bu");
+    if (kbl && !mxIsEmpty(kbl) && kbu && !mxIsEmpty(kbu)) {
+        if (mxGetNumberOfElements(kbl) != mxGetNumberOfElements(kbu)) {
+            return "Cone fields `bl` and `bu` must be the same length.";
+        }
+        /* box cone also contains the scale variable t */
+        k->bsize = (scs_int)mxGetNumberOfElements(kbl) + 1;
+        k->bl = scs_malloc(sizeof(scs_float) * (k->bsize - 1));
+        k->bu = scs_malloc(sizeof(scs_float) * (k->bsize - 1));
+        for (i = 0; i < k->bsize - 1; i++) {
+            k->bl[i] = (scs_float)mxGetPr(kbl)[i];
+            k->bu[i] = (scs_float)mxGetPr(kbu)[i];
+        }
+    } else {
+        k->bsize = 0;
+        k->bl = SCS_NULL;
+        k->bu = SCS_NULL;
+    }
+
     kep = mxGetField(cone, 0, "ep");
     if (kep && !mxIsEmpty(kep))
         k->ep = (scs_int)*mxGetPr(kep);
@@ -238,7 +346,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         if (ns > 1 && q_dims[0] == 1) {
             k->qsize = (scs_int)q_dims[1];
         }
-        k->q = mxMalloc(sizeof(scs_int) * k->qsize);
+        k->q = scs_malloc(sizeof(scs_int) * k->qsize);
         for (i = 0; i < k->qsize; i++) {
             k->q[i] = (scs_int)q_mex[i];
         }
@@ -247,6 +355,24 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         k->q = SCS_NULL;
     }
 
+    kr = mxGetField(cone, 0, "r");
+    if (kr && !mxIsEmpty(kr)) {
+        r_mex = mxGetPr(kr);
+        ns = (scs_int)mxGetNumberOfDimensions(kr);
+        r_dims = mxGetDimensions(kr);
+        k->rsize = (scs_int)r_dims[0];
+        if (ns > 1 && r_dims[0] == 1) {
+            k->rsize = (scs_int)r_dims[1];
+        }
+        k->r = scs_malloc(sizeof(scs_int) * k->rsize);
+        for (i = 0; i < k->rsize; i++) {
+            k->r[i] = (scs_int)r_mex[i];
+        }
+    } else {
+        k->rsize = 0;
+        k->r = SCS_NULL;
+    }
+
     ks = mxGetField(cone, 0, "s");
     if (ks && !mxIsEmpty(ks)) {
         s_mex = mxGetPr(ks);
@@ -256,7 +382,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         if (ns > 1 && s_dims[0] == 1) {
             k->ssize = (scs_int)s_dims[1];
         }
-        k->s = mxMalloc(sizeof(scs_int) * k->ssize);
+        k->s = scs_malloc(sizeof(scs_int) * k->ssize);
         for (i = 0; i < k->ssize; i++) {
             k->s[i] = (scs_int)s_mex[i];
         }
@@ -274,7 +400,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         if (ns > 1 && p_dims[0] == 1) {
             k->psize = (scs_int)p_dims[1];
         }
-        k->p = mxMalloc(sizeof(scs_float) * k->psize);
+        k->p = scs_malloc(sizeof(scs_float) * k->psize);
         for (i = 0; i < k->psize; i++) {
             k->p[i] = (scs_float)p_mex[i];
         }
@@ -282,91 +408,248 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         k->psize = 0;
         k->p = SCS_NULL;
     }
+    return SCS_NULL;
+}
 
-    A = scs_malloc(sizeof(AMatrix));
-    A->n = d->n;
-    A->m = d->m;
-/* TODO:
- * these return (mwIndex *), equivalent to (size_t *)
- * casting as (scs_int *), when scs_int = long seems to work
- * although maybe not on all machines:
- *
- * If scs_int is not long, then we explictly cast the entire
- * array to get the correct width
- */
-#if DLONG > 0
-    A->p = (scs_int *)mxGetJc(A_mex);
-    A->i = (scs_int *)mxGetIr(A_mex);
-#else
-    A->p = castToScsIntArr(mxGetJc(A_mex), A->n + 1);
-    A->i = castToScsIntArr(mxGetIr(A_mex), A->p[A->n]);
+/* allocates d->stgs, k and d with the parsed problem, which on error are
+ * freed before mexErrMsgTxt */
+void parseProblem(const mxArray *data, const mxArray *cone,
+                  const mxArray *settings, Data **d, Cone **k) {
+    const char *msg;
+    *d = scs_calloc(1, sizeof(Data));
+    (*d)->stgs = scs_malloc(sizeof(Settings));
+    *k = scs_calloc(1, sizeof(Cone));
+    msg = parseData(data, *d);
+    if (!msg) {
+        msg = parseCone(cone, *k);
+    }
+    if (msg) {
+        freeMex(*d, *k);
+        mexErrMsgTxt(msg);
+    }
+    setDefaultSettings(*d);
+    parseSettings(settings, (*d)->stgs);
+}
+
+void *copyArray(const void *src, size_t size) {
+    void *dst = scs_malloc(size);
+    memcpy(dst, src, size);
+    return dst;
+}
+
+/* replaces the pointers of d into matlab arrays by copies, so that d can
+ * outlive the call that parsed it */
+void copyMexArrays(Data *d) {
+#if !(FLOAT > 0)
+    d->b = copyArray(d->b, d->m * sizeof(scs_float));
+    d->c = copyArray(d->c, d->n * sizeof(scs_float));
+    d->A->x = copyArray(d->A->x, d->A->p[d->n] * sizeof(scs_float));
 #endif
-#if FLOAT > 0
-    A->x = castToScsFloatArr(mxGetPr(A_mex), A->p[A->n]);
-#else
-    A->x = (scs_float *)mxGetPr(A_mex);
+#if DLONG > 0
+    d->A->i = copyArray(d->A->i, d->A->p[d->n] * sizeof(scs_int));
+    d->A->p = copyArray(d->A->p, (d->n + 1) * sizeof(scs_int));
 #endif
-    d->A = A;
-    /* warm-start inputs, allocates sol->x, ->y, ->s even if warm start not used
-     */
-    d->stgs->warm_start =
-        parseWarmStart((mxArray *)mxGetField(data, 0, "x"), &(sol.x), d->n);
-    d->stgs->warm_start |=
-        parseWarmStart((mxArray *)mxGetField(data, 0, "y"), &(sol.y), d->m);
-    d->stgs->warm_start |=
-        parseWarmStart((mxArray *)mxGetField(data, 0, "s"), &(sol.s), d->m);
+}
 
-    status = scs(d, k, &sol, &info);
+/* copies the dense vector v of length l into x, keeping x if v is empty */
+void updateVector(scs_float *x, const mxArray *v, scs_int l, const char *msg) {
+    scs_int i;
+    if (mxIsEmpty(v)) {
+        return;
+    }
+    if (mxIsSparse(v) || !mxIsDouble(v) ||
+        (scs_int)mxGetNumberOfElements(v) != l) {
+        mexErrMsgTxt(msg);
+    }
+    for (i = 0; i < l; i++) {
+        x[i] = (scs_float)mxGetPr(v)[i];
+    }
+}
 
-    setOutputField(&plhs[0], sol.x, d->n);
-    setOutputField(&plhs[1], sol.y, d->m);
-    setOutputField(&plhs[2], sol.s, d->m);
+const mxArray *getWarmField(const mxArray *warm, const char *name) {
+    if (warm == SCS_NULL || !mxIsStruct(warm)) {
+        return SCS_NULL;
+    }
+    return mxGetField(warm, 0, name);
+}
+
+void freeMexWork(MexWork *mw) {
+    scs_finish(mw->w);
+    freeData(mw->d, mw->k);
+    scs_free(mw);
+}
+
+/* registered with mexAtExit, runs on clear of the mex function or exit */
+void freeMexWorks(void) {
+    MexWork *mw;
+    while (works) {
+        mw = works;
+        works = mw->next;
+        freeMexWork(mw);
+    }
+}
 
-    plhs[3] = mxCreateStructArray(1, one, numInfoFields, infoFields);
+MexWork *getMexWork(const mxArray *handle) {
+    MexWork *mw;
+    if (mxIsDouble(handle) && mxGetNumberOfElements(handle) == 1) {
+        for (mw = works; mw; mw = mw->next) {
+            if (mw->id == *mxGetPr(handle)) {
+                return mw;
+            }
+        }
+    }
+    mexErrMsgTxt("Invalid workspace handle: not returned by 'init' or "
+                 "already freed by 'finish'.");
+    return SCS_NULL;
+}
 
-    mxSetField(plhs[3], 0, "status", mxCreateString(info.status));
+void initCmd(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
+    /* matlab usage: work = scs('init',data,cone,settings); */
+    MexWork *mw;
+    Data *d;
+    Cone *k;
+    Info info = {0};
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "iter", tmp);
-    *mxGetPr(tmp) = (scs_float)info.iter;
+    if (nrhs != 4) {
+        mexErrMsgTxt("'init' requires three more arguments in this order: "
+                     "data struct, cone struct, settings struct");
+    }
+    if (nlhs > 1) {
+        mexErrMsgTxt("'init' returns the workspace handle only.");
+    }
+    persist = 1;
+    parseProblem(prhs[1], prhs[2], prhs[3], &d, &k);
+    copyMexArrays(d);
+    mw = scs_calloc(1, sizeof(MexWork));
+    mw->d = d;
+    mw->k = k;
+    mw->w = scs_init(d, k, &info);
+    persist = 0;
+    if (!mw->w) {
+        freeMexWork(mw);
+        mexErrMsgTxt("scs_init failed.");
+    }
+    mw->setupTime = info.setupTime;
+    mw->id = ++lastId;
+    mw->next = works;
+    works = mw;
+    /* the mex function stays loaded while it holds workspaces, which it frees
+     * on exit */
+    mexLock();
+    mexAtExit(freeMexWorks);
+    plhs[0] = mxCreateDoubleScalar(mw->id);
+}
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "pobj", tmp);
-    *mxGetPr(tmp) = info.pobj;
+void solveCmd(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
+    /* matlab usage: [x,y,s,info] = scs('solve',work,b,c,warm); */
+    MexWork *mw;
+    Data *d;
+    Sol sol = {0};
+    Info info = {0};
+    const mxArray *warm = nrhs > 4 ? prhs[4] : SCS_NULL;
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "dobj", tmp);
-    *mxGetPr(tmp) = info.dobj;
+    if (nrhs < 2 || nrhs > 5) {
+        mexErrMsgTxt("'solve' requires a workspace handle, then optionally b, "
+                     "c and a warm-start struct with x, y, s");
+    }
+    if (nlhs > 4) {
+        mexErrMsgTxt("scs returns up to 4 output arguments only.");
+    }
+    mw = getMexWork(prhs[1]);
+    d = mw->d;
+    if (nrhs > 2) {
+        updateVector(d->b, prhs[2], d->m,
+                     "Input vector b must be dense and of its size at init");
+    }
+    if (nrhs > 3) {
+        updateVector(d->c, prhs[3], d->n,
+                     "Input vector c must be dense and of its size at init");
+    }
+    /* allocates sol->x, ->y, ->s as returned, so not persistent */
+    d->stgs->warm_start = parseWarmStart(getWarmField(warm, "x"), &(sol.x),
+                                         d->n);
+    d->stgs->warm_start |= parseWarmStart(getWarmField(warm, "y"), &(sol.y),
+                                          d->m);
+    d->stgs->warm_start |= parseWarmStart(getWarmField(warm, "s"), &(sol.s),
+                                          d->m);
+
+    persist = 1;
+    scs_solve(mw->w, d, mw->k, &sol, &info);
+    persist = 0;
+    info.setupTime = mw->setupTime;
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "resPri", tmp);
-    *mxGetPr(tmp) = info.resPri;
+    setOutputField(&plhs[0], sol.x, d->n);
+    setOutputField(&plhs[1], sol.y, d->m);
+    setOutputField(&plhs[2], sol.s, d->m);
+    setInfo(&plhs[3], &info);
+}
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "resDual", tmp);
-    *mxGetPr(tmp) = info.resDual;
+void finishCmd(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
+    /* matlab usage: scs('finish',work); */
+    MexWork *mw, **prev;
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "resInfeas", tmp);
-    *mxGetPr(tmp) = info.resInfeas;
+    if (nrhs != 2) {
+        mexErrMsgTxt("'finish' requires the workspace handle only.");
+    }
+    mw = getMexWork(prhs[1]);
+    for (prev = &works; *prev != mw; prev = &(*prev)->next)
+        ;
+    *prev = mw->next;
+    freeMexWork(mw);
+    mexUnlock();
+}
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "resUnbdd", tmp);
-    *mxGetPr(tmp) = info.resUnbdd;
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
+    /* matlab usage: [x,y,s,info] = scs(data,cone,settings);
+     * or 'init', 'solve' and 'finish' for a workspace kept between calls */
+    Data *d;
+    Cone *k;
+    Sol sol = {0};
+    Info info;
+    char cmd[8];
+#if EXTRAVERBOSE > 0
+    scs_printf("SIZE OF mwSize = %i\n", (int)sizeof(mwSize));
+    scs_printf("SIZE OF mwIndex = %i\n", (int)sizeof(mwIndex));
+#endif
 
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "relGap", tmp);
-    *mxGetPr(tmp) = info.relGap;
+    /* not left set by a call that ended in an error */
+    persist = 0;
+    if (nrhs > 0 && mxIsChar(prhs[0])) {
+        mxGetString(prhs[0], cmd, sizeof(cmd));
+        if (strcmp(cmd, "init") == 0) {
+            initCmd(nlhs, plhs, nrhs, prhs);
+        } else if (strcmp(cmd, "solve") == 0) {
+            solveCmd(nlhs, plhs, nrhs, prhs);
+        } else if (strcmp(cmd, "finish") == 0) {
+            finishCmd(nlhs, plhs, nrhs, prhs);
+        } else {
+            mexErrMsgTxt("Unknown command, use 'init', 'solve' or 'finish'.");
+        }
+        return;
+    }
+    if (nrhs != 3) {
+        mexErrMsgTxt("Three arguments are required in this order: data struct, "
+                     "cone struct, settings struct");
+    }
+    if (nlhs > 4) {
+        mexErrMsgTxt("scs returns up to 4 output arguments only.");
+    }
+    parseProblem(prhs[0], prhs[1], prhs[2], &d, &k);
+    /* warm-start inputs, allocates sol->x, ->y, ->s even if warm start not used
+     */
+    d->stgs->warm_start =
+        parseWarmStart((mxArray *)mxGetField(prhs[0], 0, "x"), &(sol.x), d->n);
+    d->stgs->warm_start |=
+        parseWarmStart((mxArray *)mxGetField(prhs[0], 0, "y"), &(sol.y), d->m);
+    d->stgs->warm_start |=
+        parseWarmStart((mxArray *)mxGetField(prhs[0], 0, "s"), &(sol.s), d->m);
 
-    /*info.time is millisecs - return value in secs */
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "setupTime", tmp);
-    *mxGetPr(tmp) = info.setupTime;
+    scs(d, k, &sol, &info);
 
-    /*info.time is millisecs - return value in secs */
-    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
-    mxSetField(plhs[3], 0, "solveTime", tmp);
-    *mxGetPr(tmp) = info.solveTime;
+    setOutputField(&plhs[0], sol.x, d->n);
+    setOutputField(&plhs[1], sol.y, d->m);
+    setOutputField(&plhs[2], sol.s, d->m);
+    setInfo(&plhs[3], &info);
 
     freeMex(d, k);
     return;
@@ -375,10 +658,16 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 void freeMex(Data *d, Cone *k) {
     if (k->q)
         scs_free(k->q);
+    if (k->r)
+        scs_free(k->r);
     if (k->s)
         scs_free(k->s);
     if (k->p)
         scs_free(k->p);
+    if (k->bl)
+        scs_free(k->bl);
+    if (k->bu)
+        scs_free(k->bu);
     if (d) {
 #if FLOAT > 0
         if (d->b)
@@ -0,0 +1,14 @@
+function [ x, y, s, info ] = scs_solve( work, b, c, warm )
+% solves the problem set up by scs_init with new b and c, those of the last
+% solve if empty or not given, warm-started from a struct with any of x, y
+% and s
+if nargin < 2
+    b = [];
+end
+if nargin < 3
+    c = [];
+end
+if nargin < 4
+    warm = [];
+end
+[  x, y, s, info  ] = feval(work.solver, 'solve', work.handle, b, c, warm);
@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 from warnings import warn
 from scipy import sparse
+import numpy as np
 import _scs_indirect
 
 __version__ = _scs_indirect.version()
@@ -15,6 +16,30 @@ def solve(probdata, cone, **kwargs):
          'y' - dual solution
          'info' - information dictionary
     """
+    return _module(kwargs).csolve(*_csolve_args(probdata, cone), **kwargs)
+
+def solve_many(problems, num_threads=0, **kwargs):
+    """
+    solves a list of independent problems, each a pair (probdata, cone) as
+    taken by solve or a triple (probdata, cone, kwargs) with settings of its
+    own, on num_threads native threads (all cores if 0); the GIL is released
+    once for the whole batch. The keyword arguments (those of solve) apply to
+    every problem. Without OpenMP in the build the problems are solved one
+    after another
+
+    @return list of the dictionaries returned by solve, in order
+    """
+    module = _module(kwargs)
+    batch = []
+    for problem in problems:
+        probdata, cone = problem[0], problem[1]
+        problem_kwargs = dict(kwargs)
+        if len(problem) > 2:
+            problem_kwargs.update(problem[2])
+        batch.append((_csolve_args(probdata, cone), problem_kwargs))
+    return module.csolve_many(batch, num_threads)
+
+def _csolve_args(probdata, cone):
     if not probdata or not cone:
         raise TypeError("Missing data or cone information")
 
@@ -47,14 +72,107 @@ def solve(probdata, cone, **kwargs):
         c = c.todense()
 
     m, n = A.shape
-    
-    Adata, Aindices, Acolptr = A.data, A.indices, A.indptr
+    return ((m, n), A.data, A.indices, A.indptr, b, c, cone, warm)
+
+def _module(kwargs):
     if kwargs.pop('gpu', False): # False by default
         import _scs_gpu
-        return _scs_gpu.csolve((m, n), Adata, Aindices, Acolptr, b, c, cone, warm, **kwargs)
-
+        return _scs_gpu
     if not kwargs.pop('use_indirect', True): # True by default
         import _scs_direct
-        return _scs_direct.csolve((m, n), Adata, Aindices, Acolptr, b, c, cone, warm, **kwargs)
+        return _scs_direct
+    return _scs_indirect
 
-    return _scs_indirect.csolve((m, n), Adata, Aindices, Acolptr, b, c, cone, warm, **kwargs)
+class Solver(object):
+    """
+    a problem set up once (A normalized and, for the direct solver, factored)
+    and then solved many times for new b and c, or new values of A with the
+    same sparsity pattern; takes the arguments of solve, warm starts go to
+    the solve method
+
+    the settings that fix the setup (normalize, scale, rho_x, and the solver
+    picked with use_indirect or gpu) stay those of the constructor; solves
+    release the GIL, but one Solver runs one call at a time
+    """
+
+    def __init__(self, probdata, cone, **kwargs):
+        if not probdata or not cone:
+            raise TypeError("Missing data or cone information")
+        if not 'A' in probdata or not 'b' in probdata or not 'c' in probdata:
+            raise TypeError("Missing one or more of A, b, c from data dictionary")
+        A = probdata['A']
+        if A is None or probdata['b'] is None or probdata['c'] is None:
+            raise TypeError("Incomplete data specification")
+        if not sparse.issparse(A):
+            raise TypeError("A is required to be a sparse matrix")
+        if not sparse.isspmatrix_csc(A):
+            warn("Converting A to a CSC (compressed sparse column) matrix; may take a while.")
+            A = A.tocsc()
+        m, n = A.shape
+        module = _module(kwargs)
+        self._nnz = A.nnz
+        self._solver = module.Solver((m, n), A.data, A.indices, A.indptr,
+                                     _dense(probdata['b']), _dense(probdata['c']),
+                                     cone, {}, **kwargs)
+
+    def solve(self, b=None, c=None, warm=None, out=None):
+        """
+        solves with new b and c, or those of the last solve if None, warm
+        started from a dictionary with any of 'x', 'y' and 's', and writing
+        into the arrays of out as in scs.solve
+
+        @return dictionary of the same form as that of scs.solve
+        """
+        kwargs = {}
+        if out:
+            kwargs['out'] = out
+        if b is not None:
+            kwargs['b'] = _dense(b)
+        if c is not None:
+            kwargs['c'] = _dense(c)
+        if warm:
+            kwargs['warm'] = warm
+        return self._solver.solve(**kwargs)
+
+    def update_A(self, values):
+        """
+        replaces the values of A, given in the order of A.data of the CSC
+        matrix passed to the constructor (or a CSC matrix with the same
+        pattern), and refactors
+        """
+        if sparse.issparse(values):
+            values = values.tocsc().data
+        values = np.asarray(values, dtype=float).ravel()
+        if values.size != self._nnz:
+            raise ValueError("update_A needs one value per entry of A")
+        self._solver.update_A(values)
+
+def _dense(v):
+    if sparse.issparse(v):
+        v = v.todense()
+    return np.asarray(v, dtype=float).ravel()
+
+def load_settings(filename):
+    """
+    reads a settings profile written by the tuner (make tune), lines of
+    'name value' with '#' comment lines
+
+    @return dictionary of keyword arguments for solve
+    """
+    bools = ('normalize', 'verbose', 'warm_start', 'polish', 'adapt_alpha',
+             'stall_stop')
+    ints = ('max_iters', 'adapt_scale')
+    settings = {}
+    with open(filename) as f:
+        for line in f:
+            fields = line.split()
+            if not fields or fields[0].startswith('#'):
+                continue
+            name, value = fields[0], float(fields[1])
+            if name in bools:
+                settings[name] = value != 0
+            elif name in ints:
+                settings[name] = int(value)
+            else:
+                settings[name] = value
+    return settings
@@ -2,8 +2,12 @@
 #include "glbopts.h"
 #include "scs.h"
 #include "cones.h"
+#include "ctrlc.h"
 #include "linsys/amatrix.h"
 #include "numpy/arrayobject.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* IMPORTANT: This code now uses numpy array types. It is a private C module
  * in the sense that end users only see the front-facing Python code in
@@ -30,6 +34,7 @@ struct ScsPyData {
     PyArrayObject *Ap;
     PyArrayObject *b;
     PyArrayObject *c;
+    int copy; /* the arrays are copies, for data kept beyond the call */
 };
 
 /* Note, Python3.x may require special handling for the scs_int and scs_float
@@ -62,20 +67,20 @@ static int getFloatType(void) {
     }
 }
 
-static PyArrayObject *getContiguous(PyArrayObject *array, int typenum) {
-    /* gets the pointer to the block of contiguous C memory */
-    /* the overhead should be small unless the numpy array has been */
-    /* reordered in some way or the data type doesn't quite match */
+static PyArrayObject *getContiguous(PyArrayObject *array, int typenum,
+                                    int copy) {
+    /* gets a C contiguous, aligned array of type typenum with the data of
+     * array: array itself when it already is one and copy is 0, so the data
+     * is not copied, else a converted copy made in one pass, as when the
+     * index width of a scipy matrix differs from scs_int */
     /* */
-    /* the "new_owner" pointer has to have Py_DECREF called on it; it owns */
-    /* the "new" array object created by PyArray_Cast */
+    /* the returned array has to have Py_DECREF called on it */
     /* */
-    PyArrayObject *tmp_arr;
-    PyArrayObject *new_owner;
-    tmp_arr = PyArray_GETCONTIGUOUS(array);
-    new_owner = (PyArrayObject *)PyArray_Cast(tmp_arr, typenum);
-    Py_DECREF(tmp_arr);
-    return new_owner;
+    int flags = NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST;
+    if (copy) {
+        flags |= NPY_ARRAY_ENSURECOPY;
+    }
+    return (PyArrayObject *)PyArray_FROM_OTF((PyObject *)array, typenum, flags);
 }
 
 static int printErr(char *key) {
@@ -109,23 +114,48 @@ static int getPosIntParam(char *key, scs_int *v, scs_int defVal,
     return 0;
 }
 
-/* gets warm starts from warm dict, doesn't destroy input warm start data */
+/* gets warm starts from warm dict, doesn't destroy input warm start data;
+ * written into *x if it is an output array already, else into a new one,
+ * the warm start may be that same output array */
 static scs_int getWarmStart(char *key, scs_float **x, scs_int l,
                             PyObject *warm) {
     PyArrayObject *x0 = (PyArrayObject *)PyDict_GetItemString(warm, key);
-    *x = scs_calloc(l, sizeof(scs_float));
+    if (!*x) {
+        *x = scs_calloc(l, sizeof(scs_float));
+    }
     if (x0) {
         if (!PyArray_ISFLOAT(x0) || PyArray_NDIM(x0) != 1 ||
             PyArray_DIM(x0, 0) != l) {
             PySys_WriteStderr("Error parsing warm-start input\n");
-            return 0;
         } else {
-            PyArrayObject *px0 = getContiguous(x0, getFloatType());
-            memcpy(*x, (scs_float *)PyArray_DATA(px0), l * sizeof(scs_float));
+            PyArrayObject *px0 = getContiguous(x0, getFloatType(), 0);
+            memmove(*x, (scs_float *)PyArray_DATA(px0), l * sizeof(scs_float));
             Py_DECREF(px0);
             return 1;
         }
     }
+    memset(*x, 0, l * sizeof(scs_float));
+    return 0;
+}
+
+/* points *x at the array out[key], if there is one, for the solve to write
+ * the solution into in place of a new array */
+static int getOutArray(char *key, scs_float **x, scs_int l, PyObject *out) {
+    PyArrayObject *x0 =
+        out ? (PyArrayObject *)PyDict_GetItemString(out, key) : SCS_NULL;
+    if (!x0) {
+        return 0;
+    }
+    if (!PyArray_Check(x0) || PyArray_TYPE(x0) != getFloatType() ||
+        PyArray_NDIM(x0) != 1 || PyArray_DIM(x0, 0) != l ||
+        !PyArray_ISCARRAY(x0)) {
+        PyErr_Format(PyExc_ValueError,
+                     "out['%s'] must be a writeable contiguous float array "
+                     "of length %li",
+                     key, (long)l);
+        return -1;
+    }
+    *x = (scs_float *)PyArray_DATA(x0);
     return 0;
 }
 
@@ -215,10 +245,16 @@ static void freePyData(Data *d, Cone *k, struct ScsPyData *ps) {
     if (k) {
         if (k->q)
             scs_free(k->q);
+        if (k->r)
+            scs_free(k->r);
         if (k->s)
             scs_free(k->s);
         if (k->p)
             scs_free(k->p);
+        if (k->bl)
+            scs_free(k->bl);
+        if (k->bu)
+            scs_free(k->bu);
         scs_free(k);
     }
     if (d) {
@@ -230,61 +266,87 @@ static void freePyData(Data *d, Cone *k, struct ScsPyData *ps) {
     }
 }
 
-static PyObject *finishWithErr(Data *d, Cone *k, struct ScsPyData *ps,
-                               char *str) {
+static int setErr(char *str) {
     PyErr_SetString(PyExc_ValueError, str);
-    freePyData(d, k, ps);
-    return SCS_NULL;
+    return -1;
+}
+
+/* points d->b at the contiguous data of b, in place of any previous one */
+static int setB(Data *d, struct ScsPyData *ps, PyArrayObject *b) {
+    if (!PyArray_ISFLOAT(b) || PyArray_NDIM(b) != 1) {
+        return setErr("b must be a dense numpy array with one dimension");
+    }
+    if (PyArray_DIM(b, 0) != d->m) {
+        return setErr("b has incompatible dimension with A");
+    }
+    if (ps->b) {
+        Py_DECREF(ps->b);
+    }
+    ps->b = getContiguous(b, getFloatType(), ps->copy);
+    d->b = (scs_float *)PyArray_DATA(ps->b);
+    return 0;
+}
+
+/* points d->c at the contiguous data of c, in place of any previous one */
+static int setC(Data *d, struct ScsPyData *ps, PyArrayObject *c) {
+    if (!PyArray_ISFLOAT(c) || PyArray_NDIM(c) != 1) {
+        return setErr("c must be a dense numpy array with one dimension");
+    }
+    if (PyArray_DIM(c, 0) != d->n) {
+        return setErr("c has incompatible dimension with A");
+    }
+    if (ps->c) {
+        Py_DECREF(ps->c);
+    }
+    ps->c = getContiguous(c, getFloatType(), ps->copy);
+    d->c = (scs_float *)PyArray_DATA(ps->c);
+    return 0;
 }
 
 static PyObject *version(PyObject *self) {
     return Py_BuildValue("s", scs_version());
 }
 
-static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
+/* parses the problem data, cone and settings of csolve and Solver into d, k
+ * and ps, with the warm start and output dicts, if given, in warm and out;
+ * returns -1 with a python exception set on failure, the caller then frees
+ * with freePyData */
+static int parseProblem(PyObject *args, PyObject *kwargs, Data *d, Cone *k,
+                        struct ScsPyData *ps, PyObject **warm,
+                        PyObject **out) {
     /* data structures for arguments */
     PyArrayObject *Ax, *Ai, *Ap, *c, *b;
-    PyObject *cone, *warm = SCS_NULL;
+    PyObject *cone;
     PyObject *verbose = SCS_NULL;
     PyObject *normalize = SCS_NULL;
+    PyObject *polish = SCS_NULL;
+    PyObject *adapt_alpha = SCS_NULL;
+    PyObject *stall_stop = SCS_NULL;
     /* get the typenum for the primitive scs_int and scs_float types */
     int scs_intType = getIntType();
     int scs_floatType = getFloatType();
-    struct ScsPyData ps = {
-        SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL,
-    };
-    /* scs data structures */
-    Data *d = scs_calloc(1, sizeof(Data));
-    Cone *k = scs_calloc(1, sizeof(Cone));
-
     AMatrix *A;
-    Sol sol = {0};
-    Info info;
+    scs_int bsize;
     char *kwlist[] = {"shape",     "Ax",    "Ai",   "Ap",      "b",
                       "c",         "cone",  "warm", "verbose", "normalize",
                       "max_iters", "scale", "eps",  "cg_rate", "alpha",
-                      "rho_x",     SCS_NULL};
+                      "rho_x",     "polish", "adapt_scale", "adapt_alpha",
+                      "stall_stop", "out",   SCS_NULL};
 
 /* parse the arguments and ensure they are the correct type */
 #ifdef DLONG
 #ifdef FLOAT
-    char *argparse_string = "(ll)O!O!O!O!O!O!|O!O!O!lfffff";
-    char *outarg_string = "{s:l,s:l,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
+    char *argparse_string = "(ll)O!O!O!O!O!O!|O!O!O!lfffffO!lO!O!O!";
 #else
-    char *argparse_string = "(ll)O!O!O!O!O!O!|O!O!O!lddddd";
-    char *outarg_string = "{s:l,s:l,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
+    char *argparse_string = "(ll)O!O!O!O!O!O!|O!O!O!ldddddO!lO!O!O!";
 #endif
 #else
 #ifdef FLOAT
-    char *argparse_string = "(ii)O!O!O!O!O!O!|O!O!O!ifffff";
-    char *outarg_string = "{s:i,s:i,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
+    char *argparse_string = "(ii)O!O!O!O!O!O!|O!O!O!ifffffO!iO!O!O!";
 #else
-    char *argparse_string = "(ii)O!O!O!O!O!O!|O!O!O!iddddd";
-    char *outarg_string = "{s:i,s:i,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
+    char *argparse_string = "(ii)O!O!O!O!O!O!|O!O!O!idddddO!iO!O!O!";
 #endif
 #endif
-    npy_intp veclen[1];
-    PyObject *x, *y, *s, *returnDict, *infoDict;
 
     d->stgs = scs_malloc(sizeof(Settings));
 
@@ -295,161 +357,182 @@ static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
             args, kwargs, argparse_string, kwlist, &(d->m), &(d->n),
             &PyArray_Type, &Ax, &PyArray_Type, &Ai, &PyArray_Type, &Ap,
             &PyArray_Type, &b, &PyArray_Type, &c, &PyDict_Type, &cone,
-            &PyDict_Type, &warm, &PyBool_Type, &verbose, &PyBool_Type,
+            &PyDict_Type, warm, &PyBool_Type, &verbose, &PyBool_Type,
             &normalize, &(d->stgs->max_iters), &(d->stgs->scale),
             &(d->stgs->eps), &(d->stgs->cg_rate), &(d->stgs->alpha),
-            &(d->stgs->rho_x))) {
+            &(d->stgs->rho_x), &PyBool_Type, &polish,
+            &(d->stgs->adapt_scale), &PyBool_Type, &adapt_alpha,
+            &PyBool_Type, &stall_stop, &PyDict_Type, out)) {
         PySys_WriteStderr("error parsing inputs\n");
-        return SCS_NULL;
+        return -1;
     }
 
     if (d->m < 0) {
-        PyErr_SetString(PyExc_ValueError, "m must be a positive integer");
-        return SCS_NULL;
+        return setErr("m must be a positive integer");
     }
 
     if (d->n < 0) {
-        PyErr_SetString(PyExc_ValueError, "n must be a positive integer");
-        return SCS_NULL;
+        return setErr("n must be a positive integer");
     }
 
     /* set A */
     if (!PyArray_ISFLOAT(Ax) || PyArray_NDIM(Ax) != 1) {
-        return finishWithErr(d, k, &ps, "Ax must be a numpy array of floats");
+        return setErr("Ax must be a numpy array of floats");
     }
     if (!PyArray_ISINTEGER(Ai) || PyArray_NDIM(Ai) != 1) {
-        return finishWithErr(d, k, &ps, "Ai must be a numpy array of ints");
+        return setErr("Ai must be a numpy array of ints");
     }
     if (!PyArray_ISINTEGER(Ap) || PyArray_NDIM(Ap) != 1) {
-        return finishWithErr(d, k, &ps, "Ap must be a numpy array of ints");
+        return setErr("Ap must be a numpy array of ints");
     }
-    ps.Ax = getContiguous(Ax, scs_floatType);
-    ps.Ai = getContiguous(Ai, scs_intType);
-    ps.Ap = getContiguous(Ap, scs_intType);
+    ps->Ax = getContiguous(Ax, scs_floatType, ps->copy);
+    ps->Ai = getContiguous(Ai, scs_intType, ps->copy);
+    ps->Ap = getContiguous(Ap, scs_intType, ps->copy);
 
-    A = scs_malloc(sizeof(AMatrix));
+    A = scs_calloc(1, sizeof(AMatrix));
     A->n = d->n;
     A->m = d->m;
-    A->x = (scs_float *)PyArray_DATA(ps.Ax);
-    A->i = (scs_int *)PyArray_DATA(ps.Ai);
-    A->p = (scs_int *)PyArray_DATA(ps.Ap);
+    A->x = (scs_float *)PyArray_DATA(ps->Ax);
+    A->i = (scs_int *)PyArray_DATA(ps->Ai);
+    A->p = (scs_int *)PyArray_DATA(ps->Ap);
     d->A = A;
     /*d->Anz = d->Ap[d->n]; */
     /*d->Anz = PyArray_DIM(Ai,0); */
-    /* set c */
-    if (!PyArray_ISFLOAT(c) || PyArray_NDIM(c) != 1) {
-        return finishWithErr(
-            d, k, &ps, "c must be a dense numpy array with one dimension");
-    }
-    if (PyArray_DIM(c, 0) != d->n) {
-        return finishWithErr(d, k, &ps, "c has incompatible dimension with A");
-    }
-    ps.c = getContiguous(c, scs_floatType);
-    d->c = (scs_float *)PyArray_DATA(ps.c);
-    /* set b */
-    if (!PyArray_ISFLOAT(b) || PyArray_NDIM(b) != 1) {
-        return finishWithErr(
-            d, k, &ps, "b must be a dense numpy array with one dimension");
-    }
-    if (PyArray_DIM(b, 0) != d->m) {
-        return finishWithErr(d, k, &ps, "b has incompatible dimension with A");
+    if (setC(d, ps, c) < 0 || setB(d, ps, b) < 0) {
+        return -1;
     }
-    ps.b = getContiguous(b, scs_floatType);
-    d->b = (scs_float *)PyArray_DATA(ps.b);
 
     if (getPosIntParam("f", &(k->f), 0, cone) < 0) {
-        return finishWithErr(d, k, &ps, "failed to parse cone field f");
+        return setErr("failed to parse cone field f");
     }
     if (getPosIntParam("l", &(k->l), 0, cone) < 0) {
-        return finishWithErr(d, k, &ps, "failed to parse cone field l");
+        return setErr("failed to parse cone field l");
+    }
+    if (getConeFloatArr("bl", &(k->bl), &(k->bsize), cone) < 0) {
+        return setErr("failed to parse cone field bl");
+    }
+    if (getConeFloatArr("bu", &(k->bu), &bsize, cone) < 0) {
+        return setErr("failed to parse cone field bu");
+    }
+    if (k->bsize != bsize) {
+        return setErr("bl and bu must have the same length");
+    }
+    if (k->bsize > 0) {
+        k->bsize++; /* box cone also contains the scale variable t */
     }
     if (getConeArrDim("q", &(k->q), &(k->qsize), cone) < 0) {
-        return finishWithErr(d, k, &ps, "failed to parse cone field q");
+        return setErr("failed to parse cone field q");
+    }
+    if (getConeArrDim("r", &(k->r), &(k->rsize), cone) < 0) {
+        return setErr("failed to parse cone field r");
     }
     if (getConeArrDim("s", &(k->s), &(k->ssize), cone) < 0) {
-        return finishWithErr(d, k, &ps, "failed to parse cone field s");
+        return setErr("failed to parse cone field s");
     }
     if (getConeFloatArr("p", &(k->p), &(k->psize), cone) < 0) {
-        return finishWithErr(d, k, &ps, "failed to parse cone field p");
+        return setErr("failed to parse cone field p");
     }
     if (getPosIntParam("ep", &(k->ep), 0, cone) < 0) {
-        return finishWithErr(d, k, &ps, "failed to parse cone field ep");
+        return setErr("failed to parse cone field ep");
     }
     if (getPosIntParam("ed", &(k->ed), 0, cone) < 0) {
-        return finishWithErr(d, k, &ps, "failed to parse cone field ed");
+        return setErr("failed to parse cone field ed");
     }
 
     d->stgs->verbose = verbose ? (scs_int)PyObject_IsTrue(verbose) : VERBOSE;
     d->stgs->normalize =
         normalize ? (scs_int)PyObject_IsTrue(normalize) : NORMALIZE;
+    d->stgs->polish = polish ? (scs_int)PyObject_IsTrue(polish) : POLISH;
+    d->stgs->adapt_alpha =
+        adapt_alpha ? (scs_int)PyObject_IsTrue(adapt_alpha) : ADAPT_ALPHA;
+    d->stgs->stall_stop =
+        stall_stop ? (scs_int)PyObject_IsTrue(stall_stop) : STALL_STOP;
     if (d->stgs->max_iters < 0) {
-        return finishWithErr(d, k, &ps, "max_iters must be positive");
+        return setErr("max_iters must be positive");
     }
     if (d->stgs->scale < 0) {
-        return finishWithErr(d, k, &ps, "scale must be positive");
+        return setErr("scale must be positive");
     }
     if (d->stgs->eps < 0) {
-        return finishWithErr(d, k, &ps, "eps must be positive");
+        return setErr("eps must be positive");
     }
     if (d->stgs->cg_rate < 0) {
-        return finishWithErr(d, k, &ps, "cg_rate must be positive");
+        return setErr("cg_rate must be positive");
     }
     if (d->stgs->alpha < 0) {
-        return finishWithErr(d, k, &ps, "alpha must be positive");
+        return setErr("alpha must be positive");
     }
     if (d->stgs->rho_x < 0) {
-        return finishWithErr(d, k, &ps, "rho_x must be positive");
+        return setErr("rho_x must be positive");
+    }
+    return 0;
+}
+
+/* points sol at the arrays of the out dict and puts the warm start of the
+ * warm dict in it, either dict may be null; returns -1 with a python
+ * exception set on bad output arrays */
+static int setSol(Data *d, Sol *sol, PyObject *warm, PyObject *out) {
+    if (getOutArray("x", &(sol->x), d->n, out) < 0 ||
+        getOutArray("y", &(sol->y), d->m, out) < 0 ||
+        getOutArray("s", &(sol->s), d->m, out) < 0) {
+        return -1;
     }
-    /* parse warm start if set */
     d->stgs->warm_start = WARM_START;
     if (warm) {
-        d->stgs->warm_start = getWarmStart("x", &(sol.x), d->n, warm);
-        d->stgs->warm_start |= getWarmStart("y", &(sol.y), d->m, warm);
-        d->stgs->warm_start |= getWarmStart("s", &(sol.s), d->m, warm);
+        d->stgs->warm_start = getWarmStart("x", &(sol->x), d->n, warm);
+        d->stgs->warm_start |= getWarmStart("y", &(sol->y), d->m, warm);
+        d->stgs->warm_start |= getWarmStart("s", &(sol->s), d->m, warm);
     }
-    /* release the GIL */
-    Py_BEGIN_ALLOW_THREADS
-    /* Solve! */
-    scs(d, k, &sol, &info);
-    /* reacquire the GIL */
-    Py_END_ALLOW_THREADS
+    return 0;
+}
 
-    /* create output (all data is *deep copied*) */
-    /* x */
-    /* matrix *x; */
-    /* if(!(x = Matrix_New(n,1,DOUBLE))) */
-    /*   return PyErr_NoMemory(); */
-    /* memcpy(MAT_BUFD(x), mywork->x, n*sizeof(scs_float)); */
-    veclen[0] = d->n;
-    x = PyArray_SimpleNewFromData(1, veclen, scs_floatType, sol.x);
+/* the array out[key] the solve wrote v into, or else a new one taking over v */
+static PyObject *solArray(PyObject *out, char *key, scs_float *v,
+                          scs_int len) {
+    npy_intp veclen[1];
+    PyObject *x = out ? PyDict_GetItemString(out, key) : SCS_NULL;
+    if (x) {
+        Py_INCREF(x);
+        return x;
+    }
+    veclen[0] = len;
+    x = PyArray_SimpleNewFromData(1, veclen, getFloatType(), v);
     PyArray_ENABLEFLAGS((PyArrayObject *)x, NPY_ARRAY_OWNDATA);
+    return x;
+}
 
-    /* y */
-    /* matrix *y; */
-    /* if(!(y = Matrix_New(p,1,DOUBLE))) */
-    /*   return PyErr_NoMemory(); */
-    /* memcpy(MAT_BUFD(y), mywork->y, p*sizeof(scs_float)); */
-    veclen[0] = d->m;
-    y = PyArray_SimpleNewFromData(1, veclen, scs_floatType, sol.y);
-    PyArray_ENABLEFLAGS((PyArrayObject *)y, NPY_ARRAY_OWNDATA);
-
-    /* s */
-    /* matrix *s; */
-    /* if(!(s = Matrix_New(m,1,DOUBLE))) */
-    /*   return PyErr_NoMemory(); */
-    /* memcpy(MAT_BUFD(s), mywork->s, m*sizeof(scs_float)); */
-    veclen[0] = d->m;
-    s = PyArray_SimpleNewFromData(1, veclen, scs_floatType, sol.s);
-    PyArray_ENABLEFLAGS((PyArrayObject *)s, NPY_ARRAY_OWNDATA);
+/* the dict returned by a solve, which takes over the arrays of sol that are
+ * not in out */
+static PyObject *solutionDict(const Data *d, Sol *sol, const Info *info,
+                              PyObject *out) {
+#ifdef DLONG
+#ifdef FLOAT
+    char *outarg_string = "{s:l,s:l,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
+#else
+    char *outarg_string = "{s:l,s:l,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
+#endif
+#else
+#ifdef FLOAT
+    char *outarg_string = "{s:i,s:i,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
+#else
+    char *outarg_string = "{s:i,s:i,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
+#endif
+#endif
+    PyObject *x, *y, *s, *returnDict, *infoDict;
+
+    x = solArray(out, "x", sol->x, d->n);
+    y = solArray(out, "y", sol->y, d->m);
+    s = solArray(out, "s", sol->s, d->m);
 
     infoDict = Py_BuildValue(
-        outarg_string, "statusVal", (scs_int)info.statusVal, "iter",
-        (scs_int)info.iter, "pobj", (scs_float)info.pobj, "dobj",
-        (scs_float)info.dobj, "resPri", (scs_float)info.resPri, "resDual",
-        (scs_float)info.resDual, "relGap", (scs_float)info.relGap, "resInfeas",
-        (scs_float)info.resInfeas, "resUnbdd", (scs_float)info.resUnbdd,
-        "solveTime", (scs_float)(info.solveTime), "setupTime",
-        (scs_float)(info.setupTime), "status", info.status);
+        outarg_string, "statusVal", (scs_int)info->statusVal, "iter",
+        (scs_int)info->iter, "pobj", (scs_float)info->pobj, "dobj",
+        (scs_float)info->dobj, "resPri", (scs_float)info->resPri, "resDual",
+        (scs_float)info->resDual, "relGap", (scs_float)info->relGap,
+        "resInfeas", (scs_float)info->resInfeas, "resUnbdd",
+        (scs_float)info->resUnbdd, "solveTime", (scs_float)(info->solveTime),
+        "setupTime", (scs_float)(info->setupTime), "alpha",
+        (scs_float)info->alpha, "status", info->status);
 
     returnDict = Py_BuildValue("{s:O,s:O,s:O,s:O}", "x", x, "y", y, "s", s,
                                "info", infoDict);
@@ -458,15 +541,297 @@ static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
     Py_DECREF(y);
     Py_DECREF(s);
     Py_DECREF(infoDict);
+    return returnDict;
+}
 
+static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
+    struct ScsPyData ps = {
+        SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL,
+    };
+    /* scs data structures */
+    Data *d = scs_calloc(1, sizeof(Data));
+    Cone *k = scs_calloc(1, sizeof(Cone));
+    PyObject *warm = SCS_NULL, *out = SCS_NULL, *returnDict;
+    Sol sol = {0};
+    Info info;
+
+    /* parse the problem, the output arrays and the warm start if set */
+    if (parseProblem(args, kwargs, d, k, &ps, &warm, &out) < 0 ||
+        setSol(d, &sol, warm, out) < 0) {
+        freePyData(d, k, &ps);
+        return SCS_NULL;
+    }
+    /* release the GIL */
+    Py_BEGIN_ALLOW_THREADS
+    /* Solve! */
+    scs(d, k, &sol, &info);
+    /* reacquire the GIL */
+    Py_END_ALLOW_THREADS
+
+    returnDict = solutionDict(d, &sol, &info, out);
     /* no longer need pointers to arrays that held primitives */
     freePyData(d, k, &ps);
     return returnDict;
 }
 
+/* one problem of csolve_many */
+typedef struct {
+    Data *d;
+    Cone *k;
+    struct ScsPyData ps;
+    PyObject *out;
+    Sol sol;
+    Info info;
+} ScsPyJob;
+
+/* frees the solution arrays of a job that were not taken from its out dict */
+static void freeJobSol(ScsPyJob *job) {
+    char *keys[] = {"x", "y", "s"};
+    scs_float *v[3];
+    int i;
+    v[0] = job->sol.x;
+    v[1] = job->sol.y;
+    v[2] = job->sol.s;
+    for (i = 0; i < 3; ++i) {
+        if (v[i] && !(job->out && PyDict_GetItemString(job->out, keys[i]))) {
+            scs_free(v[i]);
+        }
+    }
+}
+
+/* solves the jobs on numThreads threads (all cores if not positive), called
+ * without the GIL; the problems are independent, each solve is serial */
+static void solveJobs(ScsPyJob *jobs, scs_int num, int numThreads) {
+    scs_int i;
+#ifdef _OPENMP
+    if (numThreads <= 0) {
+        numThreads = omp_get_max_threads();
+    }
+#endif
+    /* a ctrl-c stops the solves running and the ones left */
+    startInterruptListener();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+#endif
+    for (i = 0; i < num; ++i) {
+        scs(jobs[i].d, jobs[i].k, &(jobs[i].sol), &(jobs[i].info));
+    }
+    endInterruptListener();
+}
+
+/* csolve_many(problems, num_threads): problems is a list of (args, kwargs)
+ * pairs as taken by csolve; they are all parsed, then solved with the GIL
+ * released once, and the list of their solution dicts is returned */
+static PyObject *csolveMany(PyObject *self, PyObject *args) {
+    PyObject *problems, *pargs, *pkwargs, *warm, *returnList = SCS_NULL;
+    ScsPyJob *jobs;
+    scs_int num, i, numParsed = 0;
+    int numThreads = 0;
+
+    if (!PyArg_ParseTuple(args, "O!|i", &PyList_Type, &problems,
+                          &numThreads)) {
+        return SCS_NULL;
+    }
+    num = (scs_int)PyList_Size(problems);
+    jobs = scs_calloc(num > 0 ? num : 1, sizeof(ScsPyJob));
+    for (i = 0; i < num; ++i) {
+        warm = SCS_NULL;
+        if (!PyTuple_Check(PyList_GetItem(problems, i)) ||
+            !PyArg_ParseTuple(PyList_GetItem(problems, i), "O!O!",
+                              &PyTuple_Type, &pargs, &PyDict_Type,
+                              &pkwargs)) {
+            PyErr_Format(PyExc_TypeError,
+                         "problem %li must be an (args, kwargs) pair",
+                         (long)i);
+            goto cleanup;
+        }
+        jobs[i].d = scs_calloc(1, sizeof(Data));
+        jobs[i].k = scs_calloc(1, sizeof(Cone));
+        numParsed++;
+        if (parseProblem(pargs, pkwargs, jobs[i].d, jobs[i].k, &(jobs[i].ps),
+                         &warm, &(jobs[i].out)) < 0 ||
+            setSol(jobs[i].d, &(jobs[i].sol), warm, jobs[i].out) < 0) {
+            goto cleanup;
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    solveJobs(jobs, num, numThreads);
+    Py_END_ALLOW_THREADS
+
+    returnList = PyList_New(num);
+    for (i = 0; i < num; ++i) {
+        PyList_SET_ITEM(returnList, i,
+                        solutionDict(jobs[i].d, &(jobs[i].sol),
+                                     &(jobs[i].info), jobs[i].out));
+    }
+cleanup:
+    for (i = 0; i < numParsed; ++i) {
+        if (!returnList) {
+            freeJobSol(&jobs[i]);
+        }
+        freePyData(jobs[i].d, jobs[i].k, &(jobs[i].ps));
+    }
+    scs_free(jobs);
+    return returnList;
+}
+
+#ifdef INDIRECT
+#define SOLVER_NAME "_scs_indirect.Solver"
+#elif defined GPU
+#define SOLVER_NAME "_scs_gpu.Solver"
+#else
+#define SOLVER_NAME "_scs_direct.Solver"
+#endif
+
+/* Solver keeps the workspace of scs_init between solves, so A is normalized
+ * and factored once; its data and settings live as long as it does, in copies
+ * of the caller's arrays since the workspace may point at A, b and c */
+typedef struct {
+    PyObject_HEAD
+    Data *d;
+    Cone *k;
+    struct ScsPyData ps;
+    Work *w;
+    scs_float setupTime; /* of scs_init or the last update_A, ms */
+    int busy;            /* a call is running with the GIL released */
+} ScsPySolver;
+
+static void solverDealloc(ScsPySolver *self) {
+    if (self->w) {
+        scs_finish(self->w);
+    }
+    if (self->d || self->k) {
+        freePyData(self->d, self->k, &(self->ps));
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int solverInit(ScsPySolver *self, PyObject *args, PyObject *kwargs) {
+    PyObject *warm = SCS_NULL, *out = SCS_NULL;
+    Info info = {0};
+    if (self->d) {
+        PyErr_SetString(PyExc_RuntimeError, "Solver is already initialized");
+        return -1;
+    }
+    self->d = scs_calloc(1, sizeof(Data));
+    self->k = scs_calloc(1, sizeof(Cone));
+    self->ps.copy = 1;
+    if (parseProblem(args, kwargs, self->d, self->k, &(self->ps), &warm,
+                     &out) < 0) {
+        return -1;
+    }
+    if (out) {
+        return setErr("out is an argument of solve");
+    }
+    Py_BEGIN_ALLOW_THREADS
+    self->w = scs_init(self->d, self->k, &info);
+    Py_END_ALLOW_THREADS
+    if (!self->w) {
+        return setErr("could not initialize work");
+    }
+    self->setupTime = info.setupTime;
+    return 0;
+}
+
+/* checks the solver is usable and marks it busy, as its calls release the
+ * GIL */
+static int solverAcquire(ScsPySolver *self) {
+    if (!self->w) {
+        PyErr_SetString(PyExc_RuntimeError, "Solver is not initialized");
+        return -1;
+    }
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Solver is in use by another thread");
+        return -1;
+    }
+    self->busy = 1;
+    return 0;
+}
+
+static PyObject *solverSolve(ScsPySolver *self, PyObject *args,
+                             PyObject *kwargs) {
+    PyArrayObject *b = SCS_NULL, *c = SCS_NULL;
+    PyObject *warm = SCS_NULL, *out = SCS_NULL;
+    Sol sol = {0};
+    Info info = {0};
+    char *kwlist[] = {"b", "c", "warm", "out", SCS_NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O!O!O!O!", kwlist,
+                                     &PyArray_Type, &b, &PyArray_Type, &c,
+                                     &PyDict_Type, &warm, &PyDict_Type, &out)) {
+        return SCS_NULL;
+    }
+    if (solverAcquire(self) < 0) {
+        return SCS_NULL;
+    }
+    if ((b && setB(self->d, &(self->ps), b) < 0) ||
+        (c && setC(self->d, &(self->ps), c) < 0) ||
+        setSol(self->d, &sol, warm, out) < 0) {
+        self->busy = 0;
+        return SCS_NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    scs_solve(self->w, self->d, self->k, &sol, &info);
+    Py_END_ALLOW_THREADS
+    self->busy = 0;
+    info.setupTime = self->setupTime;
+    return solutionDict(self->d, &sol, &info, out);
+}
+
+static PyObject *solverUpdateA(ScsPySolver *self, PyObject *args) {
+    PyArrayObject *Ax;
+    scs_int status;
+    timer updateTimer;
+    if (!PyArg_ParseTuple(args, "O!", &PyArray_Type, &Ax)) {
+        return SCS_NULL;
+    }
+    if (!PyArray_ISFLOAT(Ax) || PyArray_NDIM(Ax) != 1 ||
+        PyArray_DIM(Ax, 0) != PyArray_DIM(self->ps.Ax, 0)) {
+        setErr("Ax must be a numpy array of floats, one per entry of A");
+        return SCS_NULL;
+    }
+    if (solverAcquire(self) < 0) {
+        return SCS_NULL;
+    }
+    /* A points at a copy of the new values, which the workspace uses as is
+     * unless it holds a normalized copy of A */
+    Py_DECREF(self->ps.Ax);
+    self->ps.Ax = getContiguous(Ax, getFloatType(), 1);
+    self->d->A->x = (scs_float *)PyArray_DATA(self->ps.Ax);
+    Py_BEGIN_ALLOW_THREADS
+    tic(&updateTimer);
+    status = scs_update_A(self->w, self->d, self->k);
+    self->setupTime = tocq(&updateTimer);
+    Py_END_ALLOW_THREADS
+    self->busy = 0;
+    if (status < 0) {
+        setErr("could not update A");
+        return SCS_NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef solverMethods[] = {
+    {"solve", (PyCFunction)solverSolve, METH_VARARGS | METH_KEYWORDS,
+     "Solve with the current or new b and c, optionally warm started."},
+    {"update_A", (PyCFunction)solverUpdateA, METH_VARARGS,
+     "Replace the values of A, keeping its sparsity pattern."},
+    {SCS_NULL, SCS_NULL, 0, SCS_NULL} /* sentinel */
+};
+
+static PyTypeObject ScsPySolverType = {
+    PyVarObject_HEAD_INIT(SCS_NULL, 0) SOLVER_NAME, /* tp_name */
+    sizeof(ScsPySolver),                         /* tp_basicsize */
+    0,                                           /* tp_itemsize */
+    (destructor)solverDealloc,                   /* tp_dealloc */
+};
+
 static PyMethodDef scsMethods[] = {
     {"csolve", (PyCFunction)csolve, METH_VARARGS | METH_KEYWORDS,
      "Solve a convex cone problem using scs."},
+    {"csolve_many", (PyCFunction)csolveMany, METH_VARARGS,
+     "Solve a list of convex cone problems on several threads."},
     {"version", (PyCFunction)version, METH_NOARGS, "Version number for SCS."},
     {SCS_NULL, SCS_NULL, 0, SCS_NULL} /* sentinel */
 };
@@ -506,6 +871,17 @@ static PyObject *moduleinit(void) {
     if (m == SCS_NULL) {
         return SCS_NULL;
     }
+    ScsPySolverType.tp_flags = Py_TPFLAGS_DEFAULT;
+    ScsPySolverType.tp_doc = "Workspace of a convex cone problem, set up once "
+                             "by Solver(...) for many solves.";
+    ScsPySolverType.tp_methods = solverMethods;
+    ScsPySolverType.tp_init = (initproc)solverInit;
+    ScsPySolverType.tp_new = PyType_GenericNew;
+    if (PyType_Ready(&ScsPySolverType) < 0) {
+        return SCS_NULL;
+    }
+    Py_INCREF(&ScsPySolverType);
+    PyModule_AddObject(m, "Solver", (PyObject *)&ScsPySolverType);
     return m;
 };
 
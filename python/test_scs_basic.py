@@ -60,6 +60,9 @@ def test_problems():
   sol = scs.solve(data, new_cone, use_indirect = True )
   yield check_solution, sol['x'][0], 0.5
 
+  sol = scs.solve(data, cone, stall_stop=True)
+  yield check_solution, sol['x'][0], 1
+
 
 if platform.python_version_tuple() < ('3','0','0'):
   def test_problems_with_longs():
@@ -75,6 +78,66 @@ if platform.python_version_tuple() < ('3','0','0'):
     sol = scs.solve(data, new_cone, use_indirect=True )
     yield check_solution, sol['x'][0], 0.5
 
+def test_solver():
+  for indirect in (False, True):
+    solver = scs.Solver(data, cone, use_indirect=indirect)
+    sol = solver.solve()
+    yield check_solution, sol['x'][0], 1
+
+    sol = solver.solve(b=np.array([2., -0.]))
+    yield check_solution, sol['x'][0], 2
+
+    solver.update_A(np.array([2., -1.]))
+    sol = solver.solve()
+    yield check_solution, sol['x'][0], 1
+
+    sol = solver.solve(warm=sol)
+    yield check_solution, sol['x'][0], 1
+
+  yield assert_raises, ValueError, solver.update_A, np.array([1.])
+
+  # the solver keeps its own A, b and c, even when not normalized
+  for indirect in (False, True):
+    solver = scs.Solver(data, cone, use_indirect=indirect, normalize=False)
+    vals, b2 = np.array([2., -1.]), np.array([2., -0.])
+    solver.update_A(vals)
+    sol = solver.solve(b=b2)
+    yield check_solution, sol['x'][0], 1
+
+    vals *= 5
+    b2 *= 3
+    sol = solver.solve()
+    yield check_solution, sol['x'][0], 1
+
+def test_out():
+  out = {'x': np.zeros(1), 'y': np.zeros(2), 's': np.zeros(2)}
+  sol = scs.solve(data, cone, out=out)
+  yield check_solution, out['x'][0], 1
+  assert sol['x'] is out['x'] and sol['y'] is out['y']
+
+  solver = scs.Solver(data, cone)
+  cold = solver.solve(b=np.array([2., -0.]), out=out)
+  yield check_solution, out['x'][0], 2
+
+  # warm started from the solution held in the out arrays themselves
+  sol = solver.solve(b=np.array([2., -0.]), warm=cold, out=cold)
+  yield check_solution, sol['x'][0], 2
+  assert sol['info']['iter'] < cold['info']['iter']
+
+  yield check_keyword, ValueError, 'out', {'x': np.zeros(2)}
+
+def test_solve_many():
+  b2 = np.array([2., -0.])
+  sols = scs.solve_many([(data, cone), ({'A': A, 'b': b2, 'c': c}, cone),
+                         (data, cone, {'eps': 1e-5})] * 4,
+                        num_threads=3)
+  assert len(sols) == 12
+  for i, sol in enumerate(sols):
+    yield check_solution, sol['x'][0], 2 if i % 3 == 1 else 1
+
+  yield assert_raises, ValueError, scs.solve_many, [(data, cone),
+                                                   (data, {'l': -2})]
+
 def check_keyword(error_type, keyword, value):
   assert_raises(error_type, scs.solve, data, cone, **{keyword: value})
 
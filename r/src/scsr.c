@@ -66,11 +66,11 @@ SEXP populateInfoR(Info *info, scs_int *num_protectaddr) {
     scs_int num_protected = 0;
     SEXP infor, info_names, iter_r, status_r, statusVal_r, pobj_r, dobj_r,
         resPri_r, resDual_r, resInfeas_r, resUnbdd_r, relGap_r, setupTime_r,
-        solveTime_r;
+        solveTime_r, alpha_r;
 
-    PROTECT(infor = NEW_LIST(12));
+    PROTECT(infor = NEW_LIST(13));
     num_protected++;
-    PROTECT(info_names = NEW_CHARACTER(12));
+    PROTECT(info_names = NEW_CHARACTER(13));
     num_protected++;
     SET_NAMES(infor, info_names);
 
@@ -146,6 +146,12 @@ SEXP populateInfoR(Info *info, scs_int *num_protectaddr) {
     SET_STRING_ELT(info_names, 11, mkChar("solveTime"));
     SET_VECTOR_ELT(infor, 11, solveTime_r);
 
+    PROTECT(alpha_r = allocVector(REALSXP, 1));
+    num_protected++;
+    REAL(alpha_r)[0] = info->alpha;
+    SET_STRING_ELT(info_names, 12, mkChar("alpha"));
+    SET_VECTOR_ELT(infor, 12, alpha_r);
+
     *num_protectaddr += num_protected;
     return infor;
 }
@@ -158,7 +164,7 @@ SEXP scsr(SEXP data, SEXP cone, SEXP params) {
     Data *d = scs_malloc(sizeof(Data));
     Cone *k = scs_malloc(sizeof(Cone));
     Settings *stgs = scs_malloc(sizeof(Settings));
-    AMatrix *A = scs_malloc(sizeof(AMatrix));
+    AMatrix *A = scs_calloc(1, sizeof(AMatrix));
     Info *info = scs_calloc(1, sizeof(Info));
     Sol *sol = scs_calloc(1, sizeof(Sol));
 
@@ -185,13 +191,35 @@ SEXP scsr(SEXP data, SEXP cone, SEXP params) {
     /* TODO add warm starting */
     stgs->warm_start =
         getIntFromListWithDefault(params, "warm_start", WARM_START);
+    stgs->polish = getIntFromListWithDefault(params, "polish", POLISH);
+    stgs->adapt_scale =
+        getIntFromListWithDefault(params, "adapt_scale", ADAPT_SCALE);
+    stgs->adapt_alpha =
+        getIntFromListWithDefault(params, "adapt_alpha", ADAPT_ALPHA);
+    stgs->stall_stop =
+        getIntFromListWithDefault(params, "stall_stop", STALL_STOP);
+    stgs->linsys = LINSYS; /* the package is built with one backend */
     d->stgs = stgs;
 
     k->f = getIntFromListWithDefault(cone, "f", 0);
     k->l = getIntFromListWithDefault(cone, "l", 0);
+    k->bl = getFloatVectorFromList(cone, "bl", &(k->bsize));
+    k->bu = getFloatVectorFromList(cone, "bu", &len);
+    if (len != k->bsize) {
+        scs_free(info);
+        scs_free(d);
+        scs_free(k);
+        scs_free(stgs);
+        scs_free(A);
+        freeSol(sol);
+        error("Cone fields bl and bu must be the same length.");
+    }
+    /* box cone also contains the scale variable t */
+    k->bsize = k->bsize > 0 ? k->bsize + 1 : 0;
     k->ep = getIntFromListWithDefault(cone, "ep", 0);
     k->ed = getIntFromListWithDefault(cone, "ed", 0);
     k->q = getIntVectorFromList(cone, "q", &(k->qsize));
+    k->r = getIntVectorFromList(cone, "r", &(k->rsize));
     k->s = getIntVectorFromList(cone, "s", &(k->ssize));
     k->p = getFloatVectorFromList(cone, "p", &(k->psize));
 
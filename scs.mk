@@ -59,6 +59,7 @@ LINSYS = linsys
 DIRSRC = $(LINSYS)/direct
 DIRSRCEXT = $(DIRSRC)/external
 INDIRSRC = $(LINSYS)/indirect
+DENSESRC = $(LINSYS)/dense
 GPU = $(LINSYS)/gpu
 
 OUT = out
@@ -78,6 +79,10 @@ endif
 CTRLC = 1
 ifneq ($(CTRLC), 0)
 OPT_FLAGS += -DCTRLC=$(CTRLC) # graceful interrupts with ctrl-c
+ifneq ($(ISWINDOWS), 1)
+CFLAGS += -pthread # the handler is shared by concurrent solves
+LDFLAGS += -lpthread
+endif
 endif
 FLOAT = 0
 ifneq ($(FLOAT), 0)
@@ -95,6 +100,19 @@ COPYAMATRIX = 1
 ifneq ($(COPYAMATRIX), 0)
 OPT_FLAGS += -DCOPYAMATRIX=$(COPYAMATRIX) # if normalize, copy A
 endif
+# with ASYNC_RESID, adapt_scale rescales one iteration after the check it uses
+ASYNC_RESID = 0
+ifneq ($(ASYNC_RESID), 0)
+OPT_FLAGS += -DASYNC_RESID=$(ASYNC_RESID) # residual checks on a helper thread, needs pthreads, cpu linsys only
+CFLAGS += -pthread
+LDFLAGS += -lpthread
+endif
+RACE = 0
+ifneq ($(RACE), 0)
+OPT_FLAGS += -DRACE=$(RACE) # scs_race, solving under several settings concurrently, needs pthreads
+CFLAGS += -pthread
+LDFLAGS += -lpthread
+endif
 TEST_GPU_MAT_MUL = 0
 ifneq ($(TEST_GPU_MAT_MUL), 0)
 OPT_FLAGS += -DTEST_GPU_MAT_MUL=$(TEST_GPU_MAT_MUL) # tests GPU matrix multiply for correctness
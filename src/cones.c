@@ -6,6 +6,15 @@
 #define CONE_THRESH (1e-6)
 #define EXP_CONE_MAX_ITERS (100)
 #define POW_CONE_MAX_ITERS (20)
+#define BOX_CONE_MAX_ITERS (100)
+/* SOCs of at most this size are projected in batches of equal-sized cones */
+#define SOC_BATCH_MAX_SIZE (16)
+/* number of cones gathered into the batch workspace at a time */
+#define SOC_BATCH_CHUNK (64)
+/* SOCs of at least this size are projected with the blocked kernel */
+#define SOC_LARGE_SIZE (4096)
+/* block length used when accumulating the norm of a large SOC */
+#define SOC_BLOCK_SIZE (512)
 
 #ifdef LAPACK_LIB_FOUND
 void BLAS(syevr)(const char *jobz, const char *range, const char *uplo,
@@ -35,14 +44,26 @@ static scs_int getSdConeSize(scs_int s) {
  */
 scs_int getConeBoundaries(const Cone *k, scs_int **boundaries) {
     scs_int i, count = 0;
-    scs_int len = 1 + k->qsize + k->ssize + k->ed + k->ep + k->psize;
+    scs_int len = 1 + (k->bsize > 0) + k->qsize + k->rsize + k->ssize + k->ed +
+                  k->ep + k->psize;
     scs_int *b = scs_malloc(sizeof(scs_int) * len);
     b[count] = k->f + k->l;
     count += 1;
+    /* box cone is scaled as a single block so t * bl <= s <= t * bu is
+     * invariant under the row scaling */
+    if (k->bsize > 0) {
+        b[count] = k->bsize;
+        count += 1;
+    }
     if (k->qsize > 0) {
         memcpy(&b[count], k->q, k->qsize * sizeof(scs_int));
     }
     count += k->qsize;
+    /* rotated SOCs are invariant under a uniform scaling like SOCs */
+    if (k->rsize > 0) {
+        memcpy(&b[count], k->r, k->rsize * sizeof(scs_int));
+    }
+    count += k->rsize;
     for (i = 0; i < k->ssize; ++i) {
         b[count + i] = getSdConeSize(k->s[i]);
     }
@@ -59,17 +80,35 @@ scs_int getConeBoundaries(const Cone *k, scs_int **boundaries) {
     return len;
 }
 
+scs_int getConeSignature(const Cone *k) {
+    if (k->bsize || (k->ssize && k->s) || k->ep || k->ed ||
+        (k->psize && k->p)) {
+        return CONE_SIG_GENERIC;
+    }
+    if ((k->qsize && k->q) || (k->rsize && k->r)) {
+        return CONE_SIG_LP_SOC;
+    }
+    return CONE_SIG_LP;
+}
+
 scs_int getFullConeDims(const Cone *k) {
     scs_int i, c = 0;
     if (k->f)
         c += k->f;
     if (k->l)
         c += k->l;
+    if (k->bsize)
+        c += k->bsize;
     if (k->qsize && k->q) {
         for (i = 0; i < k->qsize; ++i) {
             c += k->q[i];
         }
     }
+    if (k->rsize && k->r) {
+        for (i = 0; i < k->rsize; ++i) {
+            c += k->r[i];
+        }
+    }
     if (k->ssize && k->s) {
         for (i = 0; i < k->ssize; ++i) {
             c += getSdConeSize(k->s[i]);
@@ -99,6 +138,19 @@ scs_int validateCones(const Data *d, const Cone *k) {
         scs_printf("lp cone error\n");
         return -1;
     }
+    if (k->bsize) {
+        if (k->bsize < 0 || (k->bsize > 1 && (!k->bl || !k->bu))) {
+            scs_printf("box cone error\n");
+            return -1;
+        }
+        for (i = 0; i < k->bsize - 1; ++i) {
+            if (!(k->bl[i] <= k->bu[i])) {
+                scs_printf("box cone error, bl[%li] > bu[%li]\n", (long)i,
+                           (long)i);
+                return -1;
+            }
+        }
+    }
     if (k->qsize && k->q) {
         if (k->qsize < 0) {
             scs_printf("soc cone error\n");
@@ -111,6 +163,18 @@ scs_int validateCones(const Data *d, const Cone *k) {
             }
         }
     }
+    if (k->rsize && k->r) {
+        if (k->rsize < 0) {
+            scs_printf("rotated soc cone error\n");
+            return -1;
+        }
+        for (i = 0; i < k->rsize; ++i) {
+            if (k->r[i] < 0 || k->r[i] == 1) {
+                scs_printf("rotated soc cone error\n");
+                return -1;
+            }
+        }
+    }
     if (k->ssize && k->s) {
         if (k->ssize < 0) {
             scs_printf("sd cone error\n");
@@ -156,6 +220,16 @@ char *getConeSummary(const Info *info, ConeWork *c) {
 
 void finishCone(ConeWork *c) {
     DEBUG_FUNC
+    if (c->plan)
+        scs_free(c->plan);
+    if (c->powParams)
+        scs_free(c->powParams);
+    if (c->bl)
+        scs_free(c->bl);
+    if (c->bu)
+        scs_free(c->bu);
+    if (c->boxWork)
+        scs_free(c->boxWork);
 #ifdef LAPACK_LIB_FOUND
     if (c->Xs)
         scs_free(c->Xs);
@@ -174,7 +248,7 @@ void finishCone(ConeWork *c) {
 }
 
 char *getConeHeader(const Cone *k) {
-    char *tmp = scs_malloc(sizeof(char) * 512);
+    char *tmp = scs_malloc(sizeof(char) * 1024);
     scs_int i, socVars, socBlks, sdVars, sdBlks;
     sprintf(tmp, "Cones:");
     if (k->f) {
@@ -184,6 +258,9 @@ char *getConeHeader(const Cone *k) {
     if (k->l) {
         sprintf(tmp + strlen(tmp), "\tlinear vars: %li\n", (long)k->l);
     }
+    if (k->bsize) {
+        sprintf(tmp + strlen(tmp), "\tbox cone vars: %li\n", (long)k->bsize);
+    }
     socVars = 0;
     socBlks = 0;
     if (k->qsize && k->q) {
@@ -194,6 +271,15 @@ char *getConeHeader(const Cone *k) {
         sprintf(tmp + strlen(tmp), "\tsoc vars: %li, soc blks: %li\n",
                 (long)socVars, (long)socBlks);
     }
+    if (k->rsize && k->r) {
+        socVars = 0;
+        for (i = 0; i < k->rsize; i++) {
+            socVars += k->r[i];
+        }
+        sprintf(tmp + strlen(tmp),
+                "\trotated soc vars: %li, rotated soc blks: %li\n",
+                (long)socVars, (long)k->rsize);
+    }
     sdVars = 0;
     sdBlks = 0;
     if (k->ssize && k->s) {
@@ -371,28 +457,6 @@ scs_int setUpSdConeWorkSpace(ConeWork *c, const Cone *k) {
 #endif
 }
 
-ConeWork *initCone(const Cone *k) {
-    ConeWork *coneWork = scs_calloc(1, sizeof(ConeWork));
-#if EXTRAVERBOSE > 0
-    scs_printf("initCone\n");
-#endif
-    coneWork->totalConeTime = 0.0;
-    if (k->ssize && k->s) {
-        if (!isSimpleSemiDefiniteCone(k->s, k->ssize) &&
-            setUpSdConeWorkSpace(coneWork, k) < 0) {
-            finishCone(coneWork);
-            return SCS_NULL;
-        }
-    }
-#if EXTRAVERBOSE > 0
-    scs_printf("initCone complete\n");
-#ifdef MATLAB_MEX_FILE
-    mexEvalString("drawnow;");
-#endif
-#endif
-    return coneWork;
-}
-
 scs_int project2By2Sdc(scs_float *X) {
     scs_float a, b, d, l1, l2, x1, x2, rad;
     scs_float sqrt2 = SQRTF(2.0);
@@ -607,166 +671,497 @@ void projPowerCone(scs_float *v, scs_float a) {
     v[2] = (v[2] < 0) ? -(r) : (r);
 }
 
-/* outward facing cone projection routine, iter is outer algorithm iteration, if
-   iter < 0 then iter is ignored
-    warm_start contains guess of projection (can be set to SCS_NULL) */
-scs_int projDualCone(scs_float *x, const Cone *k, ConeWork *c,
-                     const scs_float *warm_start, scs_int iter) {
-    DEBUG_FUNC
-    scs_int i;
-    scs_int count = (k->f ? k->f : 0);
-    timer coneTimer;
-#if EXTRAVERBOSE > 0
-    timer projTimer;
-    tic(&projTimer);
-#endif
-    tic(&coneTimer);
+/* project onto a single SOC of size q, x[0] is the 'cone' variable */
+static void projSoc(scs_float *x, scs_int q) {
+    scs_float v1 = x[0];
+    scs_float s = calcNorm(&(x[1]), q - 1);
+    scs_float alpha = (s + v1) / 2.0;
 
-    if (k->l) {
-        /* project onto positive orthant */
-        for (i = count; i < count + k->l; ++i) {
-            if (x[i] < 0.0)
-                x[i] = 0.0;
-            /* x[i] = (x[i] < 0.0) ? 0.0 : x[i]; */
+    if (s <= v1) { /* do nothing */
+    } else if (s <= -v1) {
+        memset(x, 0, q * sizeof(scs_float));
+    } else {
+        x[0] = alpha;
+        scaleArray(&(x[1]), alpha / s, q - 1);
+    }
+}
+
+/* project onto a large SOC, the norm is accumulated block by block with
+ * independent partial sums so the (memory bound) pass over x is not
+ * serialized on a single accumulator, x is only re-touched if it must be
+ * scaled */
+static void projSocLarge(scs_float *x, scs_int q) {
+    scs_int i, j, len;
+    scs_float v1 = x[0], s = 0.0, alpha, s0, s1, s2, s3;
+    const scs_float *z = &(x[1]);
+    for (i = 0; i < q - 1; i += SOC_BLOCK_SIZE) {
+        len = MIN(SOC_BLOCK_SIZE, q - 1 - i);
+        s0 = s1 = s2 = s3 = 0.0;
+        for (j = 0; j + 3 < len; j += 4) {
+            s0 += z[i + j] * z[i + j];
+            s1 += z[i + j + 1] * z[i + j + 1];
+            s2 += z[i + j + 2] * z[i + j + 2];
+            s3 += z[i + j + 3] * z[i + j + 3];
         }
-        count += k->l;
-#if EXTRAVERBOSE > 0
-        scs_printf("pos orthant proj time: %1.2es\n", tocq(&projTimer) / 1e3);
-        tic(&projTimer);
-#endif
+        for (; j < len; ++j) {
+            s0 += z[i + j] * z[i + j];
+        }
+        s += (s0 + s1) + (s2 + s3);
     }
+    s = SQRTF(s);
+    if (s <= v1) { /* do nothing */
+    } else if (s <= -v1) {
+        memset(x, 0, q * sizeof(scs_float));
+    } else {
+        alpha = (s + v1) / 2.0;
+        x[0] = alpha;
+        scaleArray(&(x[1]), alpha / s, q - 1);
+    }
+}
 
-    if (k->qsize && k->q) {
-        /* project onto SOC */
-        for (i = 0; i < k->qsize; ++i) {
-            if (k->q[i] == 0) {
-                continue;
+/* project onto num consecutive SOCs all of size q, the cones are gathered
+ * SOC_BATCH_CHUNK at a time into struct-of-arrays workspace so the norm,
+ * branch and scale steps run as straight loops across cones */
+static void projSocBatch(scs_float *x, scs_int q, scs_int num) {
+    scs_int i, j, k, nb;
+    scs_float t[SOC_BATCH_CHUNK], s[SOC_BATCH_CHUNK], sc[SOC_BATCH_CHUNK];
+    scs_float *xb;
+    for (i = 0; i < num; i += SOC_BATCH_CHUNK) {
+        nb = MIN(SOC_BATCH_CHUNK, num - i);
+        xb = &(x[i * q]);
+        for (j = 0; j < nb; ++j) {
+            t[j] = xb[j * q];
+            s[j] = 0.0;
+        }
+        for (k = 1; k < q; ++k) {
+            for (j = 0; j < nb; ++j) {
+                s[j] += xb[j * q + k] * xb[j * q + k];
             }
-            if (k->q[i] == 1) {
-                if (x[count] < 0.0)
-                    x[count] = 0.0;
+        }
+        for (j = 0; j < nb; ++j) {
+            s[j] = SQRTF(s[j]);
+            if (s[j] <= t[j]) { /* do nothing */
+                sc[j] = 1.0;
+            } else if (s[j] <= -t[j]) {
+                t[j] = 0.0;
+                sc[j] = 0.0;
             } else {
-                scs_float v1 = x[count];
-                scs_float s = calcNorm(&(x[count + 1]), k->q[i] - 1);
-                scs_float alpha = (s + v1) / 2.0;
-
-                if (s <= v1) { /* do nothing */
-                } else if (s <= -v1) {
-                    memset(&(x[count]), 0, k->q[i] * sizeof(scs_float));
-                } else {
-                    x[count] = alpha;
-                    scaleArray(&(x[count + 1]), alpha / s, k->q[i] - 1);
-                }
+                t[j] = (s[j] + t[j]) / 2.0;
+                sc[j] = t[j] / s[j];
+            }
+        }
+        for (j = 0; j < nb; ++j) {
+            xb[j * q] = t[j];
+            for (k = 1; k < q; ++k) {
+                xb[j * q + k] *= sc[j];
             }
-            count += k->q[i];
         }
-#if EXTRAVERBOSE > 0
-        scs_printf("SOC proj time: %1.2es\n", tocq(&projTimer) / 1e3);
-        tic(&projTimer);
-#endif
     }
+}
 
-    if (k->ssize && k->s) {
-        /* project onto PSD cone */
-        for (i = 0; i < k->ssize; ++i) {
-#if EXTRAVERBOSE > 0
-            scs_printf("SD proj size %li\n", (long)k->s[i]);
-#endif
-            if (k->s[i] == 0) {
-                continue;
-            }
-            if (projSemiDefiniteCone(&(x[count]), k->s[i], c, iter) < 0)
-                return -1;
-            count += getSdConeSize(k->s[i]);
+/* project onto num consecutive SOCs of size q using the best kernel */
+static void projSocRun(scs_float *x, scs_int q, scs_int num) {
+    scs_int i;
+    if (q <= SOC_BATCH_MAX_SIZE && num > 1) {
+        projSocBatch(x, q, num);
+    } else if (q >= SOC_LARGE_SIZE) {
+        for (i = 0; i < num; ++i) {
+            projSocLarge(&(x[i * q]), q);
+        }
+    } else {
+        for (i = 0; i < num; ++i) {
+            projSoc(&(x[i * q]), q);
         }
+    }
+}
+
+/* project onto num consecutive rotated SOCs {(u, v, z) : 2uv >= ||z||^2,
+ * u, v >= 0} of size q, the cone is the image of the SOC under the orthogonal
+ * map (u, v) -> ((u + v), (u - v)) / sqrt(2), which is applied to the first
+ * two entries in place so z is only touched if it must be scaled */
+static void projRotSocRun(scs_float *x, scs_int q, scs_int num) {
+    scs_int i;
+    scs_float t, w, s, alpha, *xi;
+    const scs_float sqrt2Inv = 1.0 / SQRTF(2.0);
+    for (i = 0; i < num; ++i) {
+        xi = &(x[i * q]);
+        t = (xi[0] + xi[1]) * sqrt2Inv;
+        w = (xi[0] - xi[1]) * sqrt2Inv;
+        s = SQRTF(w * w + calcNormSq(&(xi[2]), q - 2));
+        if (s <= t) { /* do nothing */
+        } else if (s <= -t) {
+            memset(xi, 0, q * sizeof(scs_float));
+        } else {
+            alpha = (s + t) / 2.0;
+            w *= alpha / s;
+            xi[0] = (alpha + w) * sqrt2Inv;
+            xi[1] = (alpha - w) * sqrt2Inv;
+            scaleArray(&(xi[2]), alpha / s, q - 2);
+        }
+    }
+}
+
+/* derivative (halved) of the squared distance from (t0, s0) to the box cone
+ * as a function of the scale t >= 0, with s the closest point of
+ * [t * bl, t * bu] to s0, slope receives the derivative of the same */
+static scs_float boxCalcGrad(scs_float t, scs_float t0, const scs_float *s0,
+                             const scs_float *bl, const scs_float *bu,
+                             scs_int len, scs_float *slope) {
+    scs_int i;
+    scs_float g = t - t0;
+    *slope = 1.0;
+    for (i = 0; i < len; ++i) {
+        if (s0[i] < t * bl[i]) {
+            g += (t * bl[i] - s0[i]) * bl[i];
+            *slope += bl[i] * bl[i];
+        } else if (s0[i] > t * bu[i]) {
+            g += (t * bu[i] - s0[i]) * bu[i];
+            *slope += bu[i] * bu[i];
+        }
+    }
+    return g;
+}
+
+/* project v = (t, s) onto the box cone {(t, s) : t >= 0, t * bl <= s <= t * bu}
+ * the squared distance is convex and piecewise quadratic in t, so its
+ * derivative is found with Newton's method safeguarded by bisection */
+static void projBoxCone(scs_float *v, const scs_float *bl, const scs_float *bu,
+                        scs_int len) {
+    scs_int i;
+    scs_float t0 = v[0], *s = &(v[1]), lb = 0.0, ub, t, g, slope;
+
+    if (boxCalcGrad(0.0, t0, s, bl, bu, len, &slope) >= 0) {
+        /* minimizer at t = 0, where the cone is just the origin */
+        memset(v, 0, (len + 1) * sizeof(scs_float));
+        return;
+    }
+    /* bracket the root of the derivative */
+    ub = MAX(t0, 1.0);
+    while (boxCalcGrad(ub, t0, s, bl, bu, len, &slope) < 0) {
+        lb = ub;
+        ub *= 2;
+    }
+    t = lb;
+    for (i = 0; i < BOX_CONE_MAX_ITERS; ++i) {
+        g = boxCalcGrad(t, t0, s, bl, bu, len, &slope);
+        if (ABS(g) < CONE_TOL || ub - lb < CONE_TOL) {
+            break;
+        }
+        if (g < 0) {
+            lb = t;
+        } else {
+            ub = t;
+        }
+        t = t - g / slope;
+        if (t <= lb || t >= ub) {
+            t = (lb + ub) / 2;
+        }
+    }
+    v[0] = t;
+    for (i = 0; i < len; ++i) {
+        s[i] = MIN(MAX(s[i], t * bl[i]), t * bu[i]);
+    }
+}
+
+static scs_int projLpBlock(scs_float *x, const ConeBlock *b, ConeWork *c,
+                           scs_int iter) {
+    scs_int i;
+    /* project onto positive orthant */
+    for (i = 0; i < b->num; ++i) {
+        if (x[i] < 0.0)
+            x[i] = 0.0;
+    }
+    return 0;
+}
+
+static scs_int projBoxBlock(scs_float *x, const ConeBlock *b, ConeWork *c,
+                            scs_int iter) {
+    scs_int i;
+    /* box cone is not self dual, project onto its dual via Moreau
+     * \Pi_C^*(y) = y + \Pi_C(-y) */
+    for (i = 0; i < b->size; ++i) {
+        c->boxWork[i] = -x[i];
+    }
+    projBoxCone(c->boxWork, c->bl, c->bu, b->size - 1);
+    addScaledArray(x, c->boxWork, b->size, 1.0);
+    return 0;
+}
+
+static scs_int projSocBlock(scs_float *x, const ConeBlock *b, ConeWork *c,
+                            scs_int iter) {
+    projSocRun(x, b->size, b->num);
+    return 0;
+}
+
+static scs_int projRotSocBlock(scs_float *x, const ConeBlock *b, ConeWork *c,
+                               scs_int iter) {
+    /* rotated SOC is self dual */
+    projRotSocRun(x, b->size, b->num);
+    return 0;
+}
+
+static scs_int projSdBlock(scs_float *x, const ConeBlock *b, ConeWork *c,
+                           scs_int iter) {
+    scs_int i;
+    for (i = 0; i < b->num; ++i) {
 #if EXTRAVERBOSE > 0
-        scs_printf("SD proj time: %1.2es\n", tocq(&projTimer) / 1e3);
-        tic(&projTimer);
+        scs_printf("SD proj size %li\n", (long)b->dim);
 #endif
+        if (projSemiDefiniteCone(&(x[i * b->size]), b->dim, c, iter) < 0)
+            return -1;
     }
+    return 0;
+}
 
-    if (k->ep) {
-        scs_float r, s, t;
-        scs_int idx;
-        /*
-         * exponential cone is not self dual, if s \in K
-         * then y \in K^* and so if K is the primal cone
-         * here we project onto K^*, via Moreau
-         * \Pi_C^*(y) = y + \Pi_C(-y)
-         */
-        scaleArray(&(x[count]), -1, 3 * k->ep); /* x = -x; */
+static scs_int projExpPrimalBlock(scs_float *x, const ConeBlock *b,
+                                  ConeWork *c, scs_int iter) {
+    scs_float r, s, t;
+    scs_int i, idx;
+    /*
+     * exponential cone is not self dual, if s \in K
+     * then y \in K^* and so if K is the primal cone
+     * here we project onto K^*, via Moreau
+     * \Pi_C^*(y) = y + \Pi_C(-y)
+     */
+    scaleArray(x, -1, 3 * b->num); /* x = -x; */
 #ifdef _OPENMP
 #pragma omp parallel for private(r, s, t, idx)
 #endif
-        for (i = 0; i < k->ep; ++i) {
-            idx = count + 3 * i;
-            r = x[idx];
-            s = x[idx + 1];
-            t = x[idx + 2];
+    for (i = 0; i < b->num; ++i) {
+        idx = 3 * i;
+        r = x[idx];
+        s = x[idx + 1];
+        t = x[idx + 2];
 
-            projExpCone(&(x[idx]), iter);
+        projExpCone(&(x[idx]), iter);
 
-            x[idx] -= r;
-            x[idx + 1] -= s;
-            x[idx + 2] -= t;
-        }
-        count += 3 * k->ep;
-#if EXTRAVERBOSE > 0
-        scs_printf("EP proj time: %1.2es\n", tocq(&projTimer) / 1e3);
-        tic(&projTimer);
-#endif
+        x[idx] -= r;
+        x[idx + 1] -= s;
+        x[idx + 2] -= t;
     }
+    return 0;
+}
 
-    if (k->ed) {
+static scs_int projExpDualBlock(scs_float *x, const ConeBlock *b, ConeWork *c,
+                                scs_int iter) {
+    scs_int i;
 /* exponential cone: */
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for (i = 0; i < k->ed; ++i) {
-            projExpCone(&(x[count + 3 * i]), iter);
+    for (i = 0; i < b->num; ++i) {
+        projExpCone(&(x[3 * i]), iter);
+    }
+    return 0;
+}
+
+static scs_int projPowerBlock(scs_float *x, const ConeBlock *b, ConeWork *c,
+                              scs_int iter) {
+    scs_float v[3];
+    scs_int i, idx;
+    /* don't use openmp for power cone
+    ifdef _OPENMP
+    pragma omp parallel for private(v, idx)
+    endif
+    */
+    for (i = 0; i < b->num; ++i) {
+        idx = 3 * i;
+        if (b->param[i] <= 0) {
+            /* dual power cone */
+            projPowerCone(&(x[idx]), -b->param[i]);
+        } else {
+            /* primal power cone, using Moreau */
+            v[0] = -x[idx];
+            v[1] = -x[idx + 1];
+            v[2] = -x[idx + 2];
+
+            projPowerCone(v, b->param[i]);
+
+            x[idx] += v[0];
+            x[idx + 1] += v[1];
+            x[idx + 2] += v[2];
         }
-        count += 3 * k->ed;
-#if EXTRAVERBOSE > 0
-        scs_printf("ED proj time: %1.2es\n", tocq(&projTimer) / 1e3);
-        tic(&projTimer);
-#endif
     }
+    return 0;
+}
 
+/* appends one cone to the plan, merging it into the last block when that block
+ * is the same kind of cone, of the same size, and directly precedes it */
+static void addToPlan(ConeWork *c, coneProjFn proj, const char *name,
+                      scs_int offset, scs_int size, scs_int dim,
+                      const scs_float *param) {
+    ConeBlock *b = c->planLen > 0 ? &(c->plan[c->planLen - 1]) : SCS_NULL;
+    if (b && b->proj == proj && b->size == size && b->dim == dim &&
+        b->offset + b->size * b->num == offset &&
+        (!param || param == b->param + b->num)) {
+        b->num++;
+        return;
+    }
+    b = &(c->plan[c->planLen++]);
+    b->proj = proj;
+    b->name = name;
+    b->offset = offset;
+    b->size = size;
+    b->num = 1;
+    b->dim = dim;
+    b->param = param;
+}
+
+/* walks the cone struct once and compiles the flat projection plan, cones of
+ * zero size and the zero cone (whose dual is free) are left out */
+static scs_int setUpConePlan(ConeWork *c, const Cone *k) {
+    scs_int i, count = (k->f ? k->f : 0);
+    scs_int maxLen = 5 + (k->q ? k->qsize : 0) + (k->r ? k->rsize : 0) +
+                     (k->s ? k->ssize : 0) + (k->p ? k->psize : 0);
+    c->plan = scs_calloc(maxLen, sizeof(ConeBlock));
+    c->planLen = 0;
+    if (!c->plan) {
+        return -1;
+    }
+    if (k->l) {
+        addToPlan(c, &projLpBlock, "pos orthant", count, 1, 0, SCS_NULL);
+        c->plan[c->planLen - 1].num = k->l;
+        count += k->l;
+    }
+    if (k->bsize) {
+        c->bl = scs_malloc(MAX(k->bsize - 1, 1) * sizeof(scs_float));
+        c->bu = scs_malloc(MAX(k->bsize - 1, 1) * sizeof(scs_float));
+        c->boxWork = scs_malloc(k->bsize * sizeof(scs_float));
+        if (!c->bl || !c->bu || !c->boxWork) {
+            return -1;
+        }
+        if (k->bsize > 1) {
+            memcpy(c->bl, k->bl, (k->bsize - 1) * sizeof(scs_float));
+            memcpy(c->bu, k->bu, (k->bsize - 1) * sizeof(scs_float));
+        }
+        addToPlan(c, &projBoxBlock, "Box", count, k->bsize, 0, SCS_NULL);
+        count += k->bsize;
+    }
+    if (k->qsize && k->q) {
+        for (i = 0; i < k->qsize; ++i) {
+            if (k->q[i] > 0) {
+                addToPlan(c, &projSocBlock, "SOC", count, k->q[i], 0,
+                          SCS_NULL);
+            }
+            count += k->q[i];
+        }
+    }
+    if (k->rsize && k->r) {
+        for (i = 0; i < k->rsize; ++i) {
+            if (k->r[i] > 0) {
+                addToPlan(c, &projRotSocBlock, "Rotated SOC", count, k->r[i],
+                          0, SCS_NULL);
+            }
+            count += k->r[i];
+        }
+    }
+    if (k->ssize && k->s) {
+        for (i = 0; i < k->ssize; ++i) {
+            if (k->s[i] > 0) {
+                addToPlan(c, &projSdBlock, "SD", count,
+                          getSdConeSize(k->s[i]), k->s[i], SCS_NULL);
+            }
+            count += getSdConeSize(k->s[i]);
+        }
+    }
+    if (k->ep) {
+        addToPlan(c, &projExpPrimalBlock, "EP", count, 3, 0, SCS_NULL);
+        c->plan[c->planLen - 1].num = k->ep;
+        count += 3 * k->ep;
+    }
+    if (k->ed) {
+        addToPlan(c, &projExpDualBlock, "ED", count, 3, 0, SCS_NULL);
+        c->plan[c->planLen - 1].num = k->ed;
+        count += 3 * k->ed;
+    }
     if (k->psize && k->p) {
-        scs_float v[3];
-        scs_int idx;
-        /* don't use openmp for power cone
-        ifdef _OPENMP
-        pragma omp parallel for private(v, idx)
-        endif
-        */
+        c->powParams = scs_malloc(k->psize * sizeof(scs_float));
+        if (!c->powParams) {
+            return -1;
+        }
+        memcpy(c->powParams, k->p, k->psize * sizeof(scs_float));
         for (i = 0; i < k->psize; ++i) {
-            idx = count + 3 * i;
-            if (k->p[i] <= 0) {
-                /* dual power cone */
-                projPowerCone(&(x[idx]), -k->p[i]);
-            } else {
-                /* primal power cone, using Moreau */
-                v[0] = -x[idx];
-                v[1] = -x[idx + 1];
-                v[2] = -x[idx + 2];
+            addToPlan(c, &projPowerBlock, "Power cone", count, 3, 0,
+                      &(c->powParams[i]));
+            count += 3;
+        }
+    }
+    return 0;
+}
 
-                projPowerCone(v, k->p[i]);
+ConeWork *initCone(const Cone *k) {
+    ConeWork *coneWork = scs_calloc(1, sizeof(ConeWork));
+#if EXTRAVERBOSE > 0
+    scs_printf("initCone\n");
+#endif
+    coneWork->totalConeTime = 0.0;
+    if (setUpConePlan(coneWork, k) < 0) {
+        finishCone(coneWork);
+        return SCS_NULL;
+    }
+    if (k->ssize && k->s) {
+        if (!isSimpleSemiDefiniteCone(k->s, k->ssize) &&
+            setUpSdConeWorkSpace(coneWork, k) < 0) {
+            finishCone(coneWork);
+            return SCS_NULL;
+        }
+    }
+#if EXTRAVERBOSE > 0
+    scs_printf("initCone complete\n");
+#ifdef MATLAB_MEX_FILE
+    mexEvalString("drawnow;");
+#endif
+#endif
+    return coneWork;
+}
 
-                x[idx] += v[0];
-                x[idx + 1] += v[1];
-                x[idx + 2] += v[2];
-            }
+void projSocCones(scs_float *x, ConeWork *c) {
+    scs_int i;
+    for (i = 0; i < c->planLen; ++i) {
+        if (c->plan[i].proj == &projSocBlock) {
+            projSocRun(&(x[c->plan[i].offset]), c->plan[i].size,
+                       c->plan[i].num);
+        } else if (c->plan[i].proj == &projRotSocBlock) {
+            projRotSocRun(&(x[c->plan[i].offset]), c->plan[i].size,
+                          c->plan[i].num);
+        }
+    }
+}
+
+/* outward facing cone projection routine, iter is outer algorithm iteration, if
+   iter < 0 then iter is ignored
+    warm_start contains guess of projection (can be set to SCS_NULL)
+    if c is SCS_NULL a temporary plan is compiled from k */
+scs_int projDualCone(scs_float *x, const Cone *k, ConeWork *c,
+                     const scs_float *warm_start, scs_int iter) {
+    DEBUG_FUNC
+    scs_int i, status = 0;
+    ConeBlock *b;
+    ConeWork *tmp = SCS_NULL;
+    timer coneTimer;
+#if EXTRAVERBOSE > 0
+    timer projTimer;
+#endif
+    if (!c) {
+        if (!(tmp = initCone(k))) {
+            RETURN - 1;
         }
-        count += 3 * k->psize;
+        c = tmp;
+    }
+    tic(&coneTimer);
+    for (i = 0; i < c->planLen && status >= 0; ++i) {
+        b = &(c->plan[i]);
 #if EXTRAVERBOSE > 0
-        scs_printf("Power cone proj time: %1.2es\n", tocq(&projTimer) / 1e3);
         tic(&projTimer);
+#endif
+        status = b->proj(&(x[b->offset]), b, c, iter);
+#if EXTRAVERBOSE > 0
+        scs_printf("%s proj time: %1.2es\n", b->name, tocq(&projTimer) / 1e3);
 #endif
     }
-    /* project onto OTHER cones */
-    if (c) {
-        c->totalConeTime += tocq(&coneTimer);
+    c->totalConeTime += tocq(&coneTimer);
+    if (tmp) {
+        finishCone(tmp);
     }
-    return 0;
+    RETURN status;
 }
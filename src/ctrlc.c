@@ -29,6 +29,8 @@ int isInterrupted(void) {
 #elif defined _WIN32 || defined _WIN64
 
 static int int_detected;
+static int depth; /* listeners open, the outermost one installs the handler */
+static volatile LONG depthLock; /* spin lock over depth, held briefly */
 BOOL WINAPI handle_ctrlc(DWORD dwCtrlType) {
     if (dwCtrlType != CTRL_C_EVENT)
         return FALSE;
@@ -37,12 +39,24 @@ BOOL WINAPI handle_ctrlc(DWORD dwCtrlType) {
 }
 
 void startInterruptListener(void) {
-    int_detected = 0;
-    SetConsoleCtrlHandler(handle_ctrlc, TRUE);
+    while (InterlockedCompareExchange(&depthLock, 1, 0)) {
+        Sleep(0);
+    }
+    if (depth++ == 0) {
+        int_detected = 0;
+        SetConsoleCtrlHandler(handle_ctrlc, TRUE);
+    }
+    InterlockedExchange(&depthLock, 0);
 }
 
 void endInterruptListener(void) {
-    SetConsoleCtrlHandler(handle_ctrlc, FALSE);
+    while (InterlockedCompareExchange(&depthLock, 1, 0)) {
+        Sleep(0);
+    }
+    if (--depth == 0) {
+        SetConsoleCtrlHandler(handle_ctrlc, FALSE);
+    }
+    InterlockedExchange(&depthLock, 0);
 }
 
 int isInterrupted(void) {
@@ -52,7 +66,13 @@ int isInterrupted(void) {
 #else /* Unix */
 
 #include <signal.h>
+#include <pthread.h>
 static int int_detected;
+/* listeners open, solves on several threads (csolve_many, scs_race, or the
+ * caller's own threads) nest in one another; only the outermost one installs
+ * and restores the handler, depth and oact are guarded by depthLock */
+static int depth;
+static pthread_mutex_t depthLock = PTHREAD_MUTEX_INITIALIZER;
 struct sigaction oact;
 void handle_ctrlc(int dummy) {
     int_detected = dummy ? dummy : -1;
@@ -60,16 +80,24 @@ void handle_ctrlc(int dummy) {
 
 void startInterruptListener(void) {
     struct sigaction act;
-    int_detected = 0;
-    act.sa_flags = 0;
-    sigemptyset(&act.sa_mask);
-    act.sa_handler = handle_ctrlc;
-    sigaction(SIGINT, &act, &oact);
+    pthread_mutex_lock(&depthLock);
+    if (depth++ == 0) {
+        int_detected = 0;
+        act.sa_flags = 0;
+        sigemptyset(&act.sa_mask);
+        act.sa_handler = handle_ctrlc;
+        sigaction(SIGINT, &act, &oact);
+    }
+    pthread_mutex_unlock(&depthLock);
 }
 
 void endInterruptListener(void) {
     struct sigaction act;
-    sigaction(SIGINT, &oact, &act);
+    pthread_mutex_lock(&depthLock);
+    if (--depth == 0) {
+        sigaction(SIGINT, &oact, &act);
+    }
+    pthread_mutex_unlock(&depthLock);
 }
 
 int isInterrupted(void) {
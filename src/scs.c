@@ -1,18 +1,58 @@
 #include "scs.h"
 #include "normalize.h"
+#if ASYNC_RESID > 0 || RACE > 0
+#include <pthread.h>
+#endif
+
+/* flags shared between threads, accessed atomically where the compiler has
+ * the builtins (every compiler pthreads are used with here) */
+#if defined __GNUC__ || defined __clang__
+#define LOAD_FLAG(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_FLAG(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define LOAD_FLAG(p) (*(p))
+#define STORE_FLAG(p, v) (*(p) = (v))
+#endif
 
 #ifndef EXTRAVERBOSE
 /* if verbose print summary output every this num iterations */
 #define PRINT_INTERVAL 100
-/* check for convergence every this num iterations */
+/* check for convergence every this num iterations to start with, the interval
+ * then adapts to the observed residual decay within the bounds below */
 #define CONVERGED_INTERVAL 20
+#define MIN_CHECK_INTERVAL 5
+#define MAX_CHECK_INTERVAL 50
 #else
 #define PRINT_INTERVAL 1
 #define CONVERGED_INTERVAL 1
+#define MIN_CHECK_INTERVAL 1
+#define MAX_CHECK_INTERVAL 1
 #endif
 
 /* tolerance at which we declare problem indeterminate */
 #define INDETERMINATE_TOL 1e-9
+/* stall detection: the iterations are cut into windows that double in length
+ * starting after this iteration, and the solve stops as inaccurate if in a
+ * window neither the distance to termination nor the fixed point residual
+ * improved on everything before it by at least this factor, if stall_stop */
+#define STALL_START 500
+#define STALL_TOL 0.9
+/* polishing treats a cone block as having y = 0 or s = 0 if its norm is below
+ * this fraction of the other */
+#define POLISH_BLOCK_TOL 1e-2
+/* adaptive scale: rescale when the primal and dual residuals differ by more
+ * than this factor, at most once per ADAPT_MIN_ITERS iterations, keeping the
+ * scale within [ADAPT_MIN_SCALE, ADAPT_MAX_SCALE] */
+#define ADAPT_RATIO 10
+#define ADAPT_MIN_ITERS 250
+#define ADAPT_MIN_SCALE 1e-4
+#define ADAPT_MAX_SCALE 1e4
+/* adaptive alpha: alpha moves by ADAPT_ALPHA_STEP within [ADAPT_ALPHA_MIN,
+ * ADAPT_ALPHA_MAX] after each window of at least ADAPT_ALPHA_ITERS iterations */
+#define ADAPT_ALPHA_STEP 0.1
+#define ADAPT_ALPHA_MIN 1.0
+#define ADAPT_ALPHA_MAX 1.9
+#define ADAPT_ALPHA_ITERS 50
 
 timer globalTimer;
 
@@ -34,26 +74,9 @@ static void freeWork(Work *w) {
     DEBUG_FUNC
     if (!w)
         RETURN;
+    /* the vectors of the workspace are one block starting at u */
     if (w->u)
         scs_free(w->u);
-    if (w->v)
-        scs_free(w->v);
-    if (w->u_t)
-        scs_free(w->u_t);
-    if (w->u_prev)
-        scs_free(w->u_prev);
-    if (w->h)
-        scs_free(w->h);
-    if (w->g)
-        scs_free(w->g);
-    if (w->b)
-        scs_free(w->b);
-    if (w->c)
-        scs_free(w->c);
-    if (w->pr)
-        scs_free(w->pr);
-    if (w->dr)
-        scs_free(w->dr);
     if (w->scal) {
         if (w->scal->D)
             scs_free(w->scal->D);
@@ -65,12 +88,13 @@ static void freeWork(Work *w) {
     RETURN;
 }
 
-static void printInitHeader(const Data *d, const Cone *k) {
+static void printInitHeader(const Data *d, const Cone *k,
+                            const LinSys *linsys) {
     DEBUG_FUNC
     scs_int i;
     Settings *stgs = d->stgs;
     char *coneStr = getConeHeader(k);
-    char *linSysMethod = getLinSysMethod(d->A, d->stgs);
+    char *linSysMethod = linsys->getLinSysMethod(d->A, d->stgs);
     for (i = 0; i < LINE_LEN; ++i) {
         scs_printf("-");
     }
@@ -114,6 +138,7 @@ static void populateOnFailure(scs_int m, scs_int n, Sol *sol, Info *info,
         info->pobj = NAN;
         info->dobj = NAN;
         info->iter = -1;
+        info->alpha = NAN;
         info->statusVal = statusVal;
         info->solveTime = NAN;
         strcpy(info->status, msg);
@@ -142,7 +167,6 @@ static scs_int failure(Work *w, scs_int m, scs_int n, Sol *sol, Info *info,
     scs_int status = stint;
     populateOnFailure(m, n, sol, info, status, ststr);
     scs_printf("Failure:%s\n", msg);
-    endInterruptListener();
     RETURN status;
 }
 
@@ -171,17 +195,21 @@ static void warmStartVars(Work *w, const Sol *sol) {
 
 static scs_float calcPrimalResid(Work *w, const scs_float *x,
                                  const scs_float *s, const scs_float tau,
-                                 scs_float *nmAxs) {
+                                 scs_float *nmAxs, scs_int iter) {
     DEBUG_FUNC
     scs_int i;
     scs_float pres = 0, scale, *pr = w->pr;
     *nmAxs = 0;
-    memset(pr, 0, w->m * sizeof(scs_float));
-    accumByA(w->A, w->p, x, pr);
+    /* A * x is left in pr by projectLinSys on checked iterations */
+    if (w->AxIter != iter) {
+        memset(pr, 0, w->m * sizeof(scs_float));
+        w->linsys->accumByA(w->A, w->p, x, pr);
+    }
+    w->AxIter = -1;
     addScaledArray(pr, s, w->m, 1.0); /* pr = Ax + s */
     for (i = 0; i < w->m; ++i) {
         scale =
-            w->stgs->normalize ? w->scal->D[i] / (w->sc_b * w->stgs->scale) : 1;
+            w->stgs->normalize ? w->scal->D[i] / (w->sc_b * w->scale) : 1;
         scale = scale * scale;
         *nmAxs += (pr[i] * pr[i]) * scale;
         pres += (pr[i] - w->b[i] * tau) * (pr[i] - w->b[i] * tau) * scale;
@@ -197,10 +225,10 @@ static scs_float calcDualResid(Work *w, const scs_float *y, const scs_float tau,
     scs_float dres = 0, scale, *dr = w->dr;
     *nmATy = 0;
     memset(dr, 0, w->n * sizeof(scs_float));
-    accumByAtrans(w->A, w->p, y, dr); /* dr = A'y */
+    w->linsys->accumByAtrans(w->A, w->p, y, dr); /* dr = A'y */
     for (i = 0; i < w->n; ++i) {
         scale =
-            w->stgs->normalize ? w->scal->E[i] / (w->sc_c * w->stgs->scale) : 1;
+            w->stgs->normalize ? w->scal->E[i] / (w->sc_c * w->scale) : 1;
         scale = scale * scale;
         *nmATy += (dr[i] * dr[i]) * scale;
         dres += (dr[i] + w->c[i] * tau) * (dr[i] + w->c[i] * tau) * scale;
@@ -209,10 +237,11 @@ static scs_float calcDualResid(Work *w, const scs_float *y, const scs_float tau,
     RETURN SQRTF(dres); /* norm(A'y + c * tau) */
 }
 
-/* calculates un-normalized quantities */
-static void calcResiduals(Work *w, struct residuals *r, scs_int iter) {
+/* calculates un-normalized quantities at the iterates u, v */
+static void calcResiduals(Work *w, const scs_float *u, const scs_float *v,
+                          struct residuals *r, scs_int iter) {
     DEBUG_FUNC
-    scs_float *x = w->u, *y = &(w->u[w->n]), *s = &(w->v[w->n]);
+    const scs_float *x = u, *y = &(u[w->n]), *s = &(v[w->n]);
     scs_float nmpr_tau, nmdr_tau, nmAxs_tau, nmATy_tau, cTx, bTy;
     scs_int n = w->n, m = w->m;
 
@@ -222,19 +251,19 @@ static void calcResiduals(Work *w, struct residuals *r, scs_int iter) {
     }
     r->lastIter = iter;
 
-    r->tau = ABS(w->u[n + m]);
-    r->kap = ABS(w->v[n + m]) /
-             (w->stgs->normalize ? (w->stgs->scale * w->sc_c * w->sc_b) : 1);
+    r->tau = ABS(u[n + m]);
+    r->kap = ABS(v[n + m]) /
+             (w->stgs->normalize ? (w->scale * w->sc_c * w->sc_b) : 1);
 
-    nmpr_tau = calcPrimalResid(w, x, s, r->tau, &nmAxs_tau);
+    nmpr_tau = calcPrimalResid(w, x, s, r->tau, &nmAxs_tau, iter);
     nmdr_tau = calcDualResid(w, y, r->tau, &nmATy_tau);
 
     r->bTy_by_tau =
         innerProd(y, w->b, m) /
-        (w->stgs->normalize ? (w->stgs->scale * w->sc_c * w->sc_b) : 1);
+        (w->stgs->normalize ? (w->scale * w->sc_c * w->sc_b) : 1);
     r->cTx_by_tau =
         innerProd(x, w->c, n) /
-        (w->stgs->normalize ? (w->stgs->scale * w->sc_c * w->sc_b) : 1);
+        (w->stgs->normalize ? (w->scale * w->sc_c * w->sc_b) : 1);
 
     r->resInfeas =
         r->bTy_by_tau < 0 ? w->nm_b * nmATy_tau / -r->bTy_by_tau : NAN;
@@ -260,8 +289,9 @@ static void coldStartVars(Work *w) {
     RETURN;
 }
 
-/* status < 0 indicates failure */
-static scs_int projectLinSys(Work *w, scs_int iter) {
+/* status < 0 indicates failure, if saveAx then A * x_t is recovered from the
+ * solve and left in pr for the residual check of this iteration */
+static scs_int projectLinSys(Work *w, scs_int iter, scs_int saveAx) {
     /* ut = u + v */
     DEBUG_FUNC
     scs_int n = w->n, m = w->m, l = n + m + 1, status;
@@ -275,7 +305,16 @@ static scs_int projectLinSys(Work *w, scs_int iter) {
                    -innerProd(w->u_t, w->g, l - 1) / (w->gTh + 1));
     scaleArray(&(w->u_t[n]), -1, m);
 
-    status = solveLinSys(w->A, w->stgs, w->p, w->u_t, w->u, iter);
+    if (saveAx) {
+        memcpy(w->pr, &(w->u_t[n]), m * sizeof(scs_float));
+    }
+    status = w->linsys->solveLinSys(w->A, w->stgs, w->p, w->u_t, w->u, iter);
+    if (saveAx) {
+        /* A * x_t = y_t + rhs, and x = x_t after the cone step since v has
+         * no x component, so pr = A * x without another pass over A */
+        addScaledArray(w->pr, &(w->u_t[n]), m, 1.0);
+        w->AxIter = iter;
+    }
 
     w->u_t[l - 1] += innerProd(w->u_t, w->h, l - 1);
 
@@ -304,8 +343,8 @@ static void updateDualVars(Work *w) {
     scs_int i, n = w->n, l = n + w->m + 1;
     /* this does not relax 'x' variable */
     for (i = n; i < l; ++i) {
-        w->v[i] += (w->u[i] - w->stgs->alpha * w->u_t[i] -
-                    (1.0 - w->stgs->alpha) * w->u_prev[i]);
+        w->v[i] += (w->u[i] - w->alpha * w->u_t[i] -
+                    (1.0 - w->alpha) * w->u_prev[i]);
     }
     RETURN;
 }
@@ -319,8 +358,8 @@ static scs_int projectCones(Work *w, const Cone *k, scs_int iter) {
         w->u[i] = w->u_t[i] - w->v[i];
     }
     for (i = n; i < l; ++i) {
-        w->u[i] = w->stgs->alpha * w->u_t[i] +
-                  (1 - w->stgs->alpha) * w->u_prev[i] - w->v[i];
+        w->u[i] = w->alpha * w->u_t[i] +
+                  (1 - w->alpha) * w->u_prev[i] - w->v[i];
     }
     /* u = [x;y;tau] */
     status = projDualCone(&(w->u[n]), k, w->coneWork, &(w->u_prev[n]), iter);
@@ -330,6 +369,89 @@ static scs_int projectCones(Work *w, const Cone *k, scs_int iter) {
     RETURN status;
 }
 
+/* LP-only fast path of projectCones and updateDualVars: the projection onto
+ * the linear cone is a clamp fused into the relaxation and dual update loop,
+ * same arithmetic as the generic path so the iterates are identical */
+static void projectConesLp(Work *w, const Cone *k) {
+    DEBUG_FUNC
+    scs_int i, n = w->n, l = n + w->m + 1, lpStart = n + k->f;
+    scs_float alpha = w->alpha;
+    scs_float *u = w->u, *v = w->v, *u_t = w->u_t, *u_prev = w->u_prev;
+    for (i = 0; i < n; ++i) {
+        u[i] = u_t[i] - v[i];
+    }
+    /* zero cone rows, dual is free */
+    for (i = n; i < lpStart; ++i) {
+        u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+        v[i] += (u[i] - alpha * u_t[i] - (1.0 - alpha) * u_prev[i]);
+    }
+    /* linear cone rows and tau */
+    for (i = lpStart; i < l; ++i) {
+        u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+        if (u[i] < 0.0)
+            u[i] = 0.0;
+        v[i] += (u[i] - alpha * u_t[i] - (1.0 - alpha) * u_prev[i]);
+    }
+    RETURN;
+}
+
+/* LP+SOC fast path of projectCones: linear cone clamp fused into the
+ * relaxation loop, SOCs projected straight from the cone plan */
+static void projectConesLpSoc(Work *w, const Cone *k) {
+    DEBUG_FUNC
+    scs_int i, n = w->n, l = n + w->m + 1, lpStart = n + k->f,
+               lpEnd = lpStart + k->l;
+    scs_float alpha = w->alpha;
+    scs_float *u = w->u, *v = w->v, *u_t = w->u_t, *u_prev = w->u_prev;
+    for (i = 0; i < n; ++i) {
+        u[i] = u_t[i] - v[i];
+    }
+    for (i = n; i < lpStart; ++i) {
+        u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+    }
+    for (i = lpStart; i < lpEnd; ++i) {
+        u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+        if (u[i] < 0.0)
+            u[i] = 0.0;
+    }
+    for (i = lpEnd; i < l; ++i) {
+        u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+    }
+    projSocCones(&(u[n]), w->coneWork);
+    if (u[l - 1] < 0.0)
+        u[l - 1] = 0.0;
+    RETURN;
+}
+
+/* projects onto the cones and updates the dual variables, using the kernel
+ * selected by the cone signature at scs_init, status < 0 indicates failure */
+static scs_int projectConesAndUpdateDualVars(Work *w, const Cone *k,
+                                             scs_int iter) {
+    DEBUG_FUNC
+    timer coneTimer;
+    /* the fast paths bypass projDualCone, so they time themselves for the
+     * cone summary, the LP one with its fused dual update */
+    switch (w->coneSig) {
+    case CONE_SIG_LP:
+        tic(&coneTimer);
+        projectConesLp(w, k);
+        w->coneWork->totalConeTime += tocq(&coneTimer);
+        break;
+    case CONE_SIG_LP_SOC:
+        tic(&coneTimer);
+        projectConesLpSoc(w, k);
+        w->coneWork->totalConeTime += tocq(&coneTimer);
+        updateDualVars(w);
+        break;
+    default:
+        if (projectCones(w, k, iter) < 0) {
+            RETURN - 1;
+        }
+        updateDualVars(w);
+    }
+    RETURN 0;
+}
+
 static scs_int indeterminate(Work *w, Sol *sol, Info *info) {
     DEBUG_FUNC
     strcpy(info->status, "Indeterminate");
@@ -420,6 +542,7 @@ static void getInfo(Work *w, Sol *sol, Info *info, struct residuals *r,
                     scs_int iter) {
     DEBUG_FUNC
     info->iter = iter;
+    info->alpha = w->alpha;
     info->resInfeas = r->resInfeas;
     info->resUnbdd = r->resUnbdd;
     if (isSolvedStatus(info->statusVal)) {
@@ -449,7 +572,7 @@ static void getSolution(Work *w, Sol *sol, Info *info, struct residuals *r,
                         scs_int iter) {
     DEBUG_FUNC
     scs_int l = w->n + w->m + 1;
-    calcResiduals(w, r, iter);
+    calcResiduals(w, w->u, w->v, r, iter);
     setx(w, sol);
     sety(w, sol);
     sets(w, sol);
@@ -575,7 +698,7 @@ static void printFooter(const Data *d, const Cone *k, Sol *sol, Work *w,
                         Info *info) {
     DEBUG_FUNC
     scs_int i;
-    char *linSysStr = getLinSysSummary(w->p, info);
+    char *linSysStr = w->linsys->getLinSysSummary(w->p, info);
     char *coneStr = getConeSummary(info, w->coneWork);
     for (i = 0; i < LINE_LEN; ++i) {
         scs_printf("-");
@@ -585,6 +708,9 @@ static void printFooter(const Data *d, const Cone *k, Sol *sol, Work *w,
         scs_printf("Hit max_iters, solution may be inaccurate\n");
     }
     scs_printf("Timing: Solve time: %1.2es\n", info->solveTime / 1e3);
+    if (w->stgs->adapt_alpha) {
+        scs_printf("Final alpha: %.2f\n", info->alpha);
+    }
 
     if (linSysStr) {
         scs_printf("%s", linSysStr);
@@ -639,6 +765,10 @@ static void printFooter(const Data *d, const Cone *k, Sol *sol, Work *w,
     RETURN;
 }
 
+/* the certificates are tested on the iterate itself: in the homogeneous
+ * embedding the iterates of an infeasible or unbounded problem converge to a
+ * certificate with tau = 0, so the step u - u_prev goes to zero rather than
+ * along a certificate and is no better a candidate */
 static scs_int hasConverged(Work *w, struct residuals *r, scs_int iter) {
     DEBUG_FUNC
     scs_float eps = w->stgs->eps;
@@ -699,35 +829,43 @@ static scs_int validate(const Data *d, const Cone *k) {
 
 static Work *initWork(const Data *d, const Cone *k) {
     DEBUG_FUNC
-    Work *w = scs_calloc(1, sizeof(Work));
+    Work *w;
     scs_int l = d->n + d->m + 1;
+    const LinSys *linsys = selectLinSys(d->A, d->stgs);
+    if (!linsys) {
+        scs_printf("ERROR: linear system solver %i not available\n",
+                   (int)d->stgs->linsys);
+        RETURN SCS_NULL;
+    }
     if (d->stgs->verbose) {
-        printInitHeader(d, k);
+        printInitHeader(d, k, linsys);
     }
+    w = scs_calloc(1, sizeof(Work));
     if (!w) {
         scs_printf("ERROR: allocating work failure\n");
         RETURN SCS_NULL;
     }
-    /* get settings and dims from data struct */
+    /* get settings, backend and dims from data struct */
     w->stgs = d->stgs;
+    w->scale = d->stgs->scale;
+    w->linsys = linsys;
     w->m = d->m;
     w->n = d->n;
-    /* allocate workspace: */
-    w->u = scs_malloc(l * sizeof(scs_float));
-    w->v = scs_malloc(l * sizeof(scs_float));
-    w->u_t = scs_malloc(l * sizeof(scs_float));
-    w->u_prev = scs_malloc(l * sizeof(scs_float));
-    w->h = scs_malloc((l - 1) * sizeof(scs_float));
-    w->g = scs_malloc((l - 1) * sizeof(scs_float));
-    w->pr = scs_malloc(d->m * sizeof(scs_float));
-    w->dr = scs_malloc(d->n * sizeof(scs_float));
-    w->b = scs_malloc(d->m * sizeof(scs_float));
-    w->c = scs_malloc(d->n * sizeof(scs_float));
-    if (!w->u || !w->v || !w->u_t || !w->u_prev || !w->h || !w->g || !w->pr ||
-        !w->dr || !w->b || !w->c) {
+    /* allocate workspace, one block for all the vectors: */
+    w->u = scs_malloc((6 * l - 2 + 2 * (d->m + d->n)) * sizeof(scs_float));
+    if (!w->u) {
         scs_printf("ERROR: work memory allocation failure\n");
         RETURN SCS_NULL;
     }
+    w->v = w->u + l;
+    w->u_t = w->v + l;
+    w->u_prev = w->u_t + l;
+    w->h = w->u_prev + l;
+    w->g = w->h + (l - 1);
+    w->pr = w->g + (l - 1);
+    w->dr = w->pr + d->m;
+    w->b = w->dr + d->n;
+    w->c = w->b + d->m;
     w->A = d->A;
     if (w->stgs->normalize) {
 #ifdef COPYAMATRIX
@@ -737,7 +875,7 @@ static Work *initWork(const Data *d, const Cone *k) {
         }
 #endif
         w->scal = scs_malloc(sizeof(Scaling));
-        normalizeA(w->A, w->stgs, k, w->scal);
+        normalizeA(w->A, w->scale, k, w->scal);
 #if EXTRAVERBOSE > 0
         printArray(w->scal->D, d->m, "D");
         scs_printf("norm D = %4f\n", calcNorm(w->scal->D, d->m));
@@ -751,7 +889,14 @@ static Work *initWork(const Data *d, const Cone *k) {
         scs_printf("ERROR: initCone failure\n");
         RETURN SCS_NULL;
     }
-    w->p = initPriv(w->A, w->stgs);
+#if EXTRAVERBOSE > 0
+    /* keep the per-cone timing and debug output of projDualCone */
+    w->coneSig = CONE_SIG_GENERIC;
+#else
+    w->coneSig = getConeSignature(k);
+#endif
+    w->AxIter = -1;
+    w->p = w->linsys->initPriv(w->A, w->stgs);
     if (!w->p) {
         scs_printf("ERROR: initPriv failure\n");
         RETURN SCS_NULL;
@@ -759,6 +904,19 @@ static Work *initWork(const Data *d, const Cone *k) {
     RETURN w;
 }
 
+/* h = [c; b] and g = (I + M)^-1 h, both depend on b, c and the linear system */
+static void calcHG(Work *w) {
+    DEBUG_FUNC
+    scs_int n = w->n, m = w->m;
+    memcpy(w->h, w->c, n * sizeof(scs_float));
+    memcpy(&(w->h[n]), w->b, m * sizeof(scs_float));
+    memcpy(w->g, w->h, (n + m) * sizeof(scs_float));
+    w->linsys->solveLinSys(w->A, w->stgs, w->p, w->g, SCS_NULL, -1);
+    scaleArray(&(w->g[n]), -1, m);
+    w->gTh = innerProd(w->h, w->g, n + m);
+    RETURN;
+}
+
 static scs_int updateWork(const Data *d, Work *w, const Sol *sol) {
     DEBUG_FUNC
     /* before normalization */
@@ -792,91 +950,618 @@ static scs_int updateWork(const Data *d, Work *w, const Sol *sol) {
     } else {
         coldStartVars(w);
     }
-    memcpy(w->h, w->c, n * sizeof(scs_float));
-    memcpy(&(w->h[n]), w->b, m * sizeof(scs_float));
-    memcpy(w->g, w->h, (n + m) * sizeof(scs_float));
-    solveLinSys(w->A, w->stgs, w->p, w->g, SCS_NULL, -1);
-    scaleArray(&(w->g[n]), -1, m);
-    w->gTh = innerProd(w->h, w->g, n + m);
+    calcHG(w);
     RETURN 0;
 }
 
-scs_int scs_solve(Work *w, const Data *d, const Cone *k, Sol *sol, Info *info) {
+/* true on iterations where the residuals are computed, every such iteration
+ * is also a convergence check */
+static scs_int isCheckIter(Work *w, scs_int iter) {
+    return iter >= w->nextCheck ||
+           (w->stgs->verbose && iter % PRINT_INTERVAL == 0);
+}
+
+/* distance from termination in multiples of eps, the smallest over the
+ * solved, infeasible and unbounded tests (NaN tests are ignored) */
+static scs_float calcProgress(Work *w, struct residuals *r) {
+    scs_float eps = w->stgs->eps;
+    scs_float prog = MAX(MAX(r->resPri, r->resDual), r->relGap) / eps;
+    if (scs_isnan(prog)) {
+        prog = INFINITY;
+    }
+    if (r->resInfeas / eps < prog) {
+        prog = r->resInfeas / eps;
+    }
+    if (r->resUnbdd / eps < prog) {
+        prog = r->resUnbdd / eps;
+    }
+    return prog;
+}
+
+/* schedules the next convergence check from the decay of the residuals since
+ * the previous check: half the iterations predicted to reach eps, so checks
+ * are sparse far from eps and close in on the stopping point, the interval at
+ * most doubles per check since the residuals do not decay monotonically */
+static void setNextCheck(Work *w, struct residuals *r, scs_int iter) {
+    scs_float prog = calcProgress(w, r), rate, interval = CONVERGED_INTERVAL;
+    if (w->lastCheck >= 0 && prog > 1 && prog < w->lastProgress &&
+        w->lastProgress < INFINITY) {
+        rate = log(w->lastProgress / prog) / (iter - w->lastCheck);
+        interval = 0.5 * log(prog) / rate;
+        interval = MIN(interval, 2 * (iter - w->lastCheck));
+    }
+    interval = MIN(MAX(interval, MIN_CHECK_INTERVAL), MAX_CHECK_INTERVAL);
+    w->nextCheck = iter + (scs_int)interval;
+    w->lastCheck = iter;
+    w->lastProgress = prog;
+}
+
+/* relative fixed point residual of the iteration just taken */
+static scs_float calcFpr(Work *w) {
+    scs_int l = w->n + w->m + 1;
+    return calcNormDiff(w->u, w->u_prev, l) /
+           MAX(calcNorm(w->u, l), INDETERMINATE_TOL);
+}
+
+/* tracks the best progress in the current window, at the end of a window
+ * returns true if it made no real improvement on the earlier iterations */
+static scs_int isStalled(Work *w, struct residuals *r, scs_int iter) {
+    scs_int stalled;
+    if (!w->stgs->stall_stop) {
+        return 0;
+    }
+    w->stallBest = MIN(w->stallBest, calcProgress(w, r));
+    w->stallBestFpr = MIN(w->stallBestFpr, r->fpr);
+    if (iter < w->stallEnd) {
+        return 0;
+    }
+    stalled = w->stallRef < INFINITY && w->stallBest > STALL_TOL * w->stallRef &&
+              w->stallBestFpr > STALL_TOL * w->stallRefFpr;
+    w->stallRef = MIN(w->stallRef, w->stallBest);
+    w->stallRefFpr = MIN(w->stallRefFpr, w->stallBestFpr);
+    w->stallBest = w->stallBestFpr = INFINITY;
+    w->stallEnd = 2 * iter;
+    if (stalled && w->stgs->verbose) {
+        scs_printf("residuals stalled, stopping at iteration %li\n",
+                   (long)iter);
+    }
+    return stalled;
+}
+
+/* rescales the normalized data when the primal and dual residuals are out of
+ * balance, a larger scale weights the dual residual more: A, b, c, s and
+ * kappa are multiplied by the change of scale while x, y and tau are
+ * invariant, and the linear system solver is updated for the new A; the
+ * balance is the geometric mean of the residual ratio over the checks since
+ * the last update, which waits twice as long as the one before it since the
+ * ratio swings a lot from check to check; the new scale is kept in w->scale
+ * and stgs->scale is left as given; with the asynchronous residual check it
+ * is only called once the helper, which reads A, b and c, is idle; returns
+ * negative on failure */
+static scs_int adaptScale(Work *w, struct residuals *r, scs_int iter) {
     DEBUG_FUNC
-    scs_int i;
+    scs_int n = w->n, m = w->m;
+    scs_float ratio = log(r->resPri / r->resDual), scale, f;
+    if (w->rescales >= w->stgs->adapt_scale || !w->stgs->normalize) {
+        RETURN 0;
+    }
+    if (!scs_isnan(ratio) && ABS(ratio) < INFINITY) {
+        w->logRatioSum += ratio;
+        w->logRatioCount++;
+    }
+    if (iter < w->lastRescale + (ADAPT_MIN_ITERS << w->rescales) ||
+        w->logRatioCount == 0) {
+        RETURN 0;
+    }
+    ratio = exp(w->logRatioSum / w->logRatioCount);
+    if (ratio < ADAPT_RATIO && ratio > 1.0 / ADAPT_RATIO) {
+        RETURN 0;
+    }
+    scale = w->scale * SQRTF(ratio);
+    scale = MIN(MAX(scale, ADAPT_MIN_SCALE), ADAPT_MAX_SCALE);
+    f = scale / w->scale;
+    if (f == 1) {
+        RETURN 0;
+    }
+    scaleAMatrix(w->A, f);
+    scaleArray(w->b, f, m);
+    scaleArray(w->c, f, n);
+    scaleArray(&(w->v[n]), f, m + 1);
+    w->scale = scale;
+    if (w->linsys->updateLinSys(w->A, w->stgs, w->p) < 0) {
+        RETURN -1;
+    }
+    calcHG(w);
+    w->rescales++;
+    w->lastRescale = iter;
+    w->logRatioSum = 0;
+    w->logRatioCount = 0;
+    w->AxIter = -1;
+    r->lastIter = -1;
+    if (w->stgs->verbose) {
+        scs_printf("iteration %li: pri/dua res ratio %.2e, scale = %.2e\n",
+                   (long)iter, ratio, scale);
+    }
+    RETURN 0;
+}
+
+/* adapts alpha by hill climbing on the contraction of the fixed point
+ * residual: a window measures the mean decay rate per iteration of the fpr,
+ * alpha keeps moving in the same direction while the rate improves on the
+ * previous window and turns around when it gets worse; as a safeguard a window
+ * in which the fpr grew sends alpha halfway back to 1, the unrelaxed
+ * iteration, and the search restarts from there */
+static void adaptAlpha(Work *w, struct residuals *r, scs_int iter) {
+    DEBUG_FUNC
+    scs_float rate;
+    if (!w->stgs->adapt_alpha || scs_isnan(r->fpr) || r->fpr <= 0) {
+        RETURN;
+    }
+    if (w->alphaIter < 0) {
+        w->alphaIter = iter;
+        w->alphaFpr = r->fpr;
+        RETURN;
+    }
+    if (iter < w->alphaIter + ADAPT_ALPHA_ITERS) {
+        RETURN;
+    }
+    rate = exp(log(r->fpr / w->alphaFpr) / (iter - w->alphaIter));
+    if (rate > 1) {
+        w->alpha = 1 + (w->alpha - 1) / 2;
+        w->alphaDir = 1;
+        w->alphaRate = INFINITY;
+    } else {
+        if (rate > w->alphaRate) {
+            w->alphaDir = -w->alphaDir;
+        }
+        w->alphaRate = rate;
+        w->alpha += w->alphaDir * ADAPT_ALPHA_STEP;
+    }
+    w->alpha = MIN(MAX(w->alpha, ADAPT_ALPHA_MIN), ADAPT_ALPHA_MAX);
+    w->alphaIter = iter;
+    w->alphaFpr = r->fpr;
+#if EXTRAVERBOSE > 0
+    scs_printf("iteration %li: fpr rate %.4f, alpha = %.2f\n", (long)iter, rate,
+               w->alpha);
+#endif
+    RETURN;
+}
+
+/* polishes a solved iterate: guesses from y and s the rows (whole blocks for
+ * cones other than zero and linear) that are active, ie have s = 0, solves the
+ * reduced KKT system for x and y with y = 0 on the inactive rows, starting
+ * from the iterate, and keeps the result, projected onto the cones, if its
+ * residuals are smaller */
+static void polish(Work *w, const Cone *k, struct residuals *r, scs_int iter) {
+    DEBUG_FUNC
+    scs_int i, j, c, count, n = w->n, m = w->m, l = n + m + 1;
+    scs_int *bnds, isActive = 0, *active = scs_malloc(m * sizeof(scs_int));
+    scs_float *z = scs_malloc((2 * (n + m) + 2 * l) * sizeof(scs_float));
+    scs_float *rhs = &(z[n + m]), *uOld = &(z[2 * (n + m)]),
+              *vOld = &(z[2 * (n + m) + l]);
+    scs_float *y = &(w->u[n]), *s = &(w->v[n]), before, after, ny, ns;
+    if (!active || !z) {
+        scs_free(active);
+        scs_free(z);
+        RETURN;
+    }
+    calcResiduals(w, w->u, w->v, r, iter);
+    before = MAX(MAX(r->resPri, r->resDual), r->relGap);
+    for (i = 0; i < k->f; ++i) {
+        active[i] = 1;
+    }
+    for (i = k->f; i < k->f + k->l; ++i) {
+        active[i] = y[i] > s[i];
+    }
+    /* a block of another cone is active or inactive as a whole, polishing
+     * gives up if neither y nor s is clearly zero on it (a face of the cone
+     * boundary is not a set of active rows) */
+    count = getConeBoundaries(k, &bnds);
+    for (j = 1, i = k->f + k->l; j < count && isActive >= 0; i += bnds[j++]) {
+        ny = calcNorm(&(y[i]), bnds[j]);
+        ns = calcNorm(&(s[i]), bnds[j]);
+        isActive = ns <= POLISH_BLOCK_TOL * ny
+                       ? 1
+                       : (ny <= POLISH_BLOCK_TOL * ns ? 0 : -1);
+        for (c = i; c < i + bnds[j]; ++c) {
+            active[c] = isActive;
+        }
+    }
+    scs_free(bnds);
+    if (isActive < 0) {
+        if (w->stgs->verbose) {
+            scs_printf("polish: skipped, solution on a cone boundary\n");
+        }
+        scs_free(active);
+        scs_free(z);
+        RETURN;
+    }
+    /* rhs [-c; b], starting from the current solution */
+    for (i = 0; i < n; ++i) {
+        rhs[i] = -w->c[i];
+    }
+    memcpy(&(rhs[n]), w->b, m * sizeof(scs_float));
+    memcpy(z, w->u, (n + m) * sizeof(scs_float));
+    scaleArray(z, 1.0 / w->u[n + m], n + m);
+    if (w->linsys->solvePolishSys(w->A, w->stgs, w->p, active, rhs, z) < 0) {
+        scs_free(active);
+        scs_free(z);
+        RETURN;
+    }
+    memcpy(uOld, w->u, l * sizeof(scs_float));
+    memcpy(vOld, w->v, l * sizeof(scs_float));
+    /* u = [x; y; 1], v = [0; b - A * x; 0] with s = 0 on the active rows */
+    memcpy(w->u, z, (n + m) * sizeof(scs_float));
+    w->u[n + m] = 1;
+    w->v[n + m] = 0;
+    memcpy(s, w->b, m * sizeof(scs_float));
+    scaleArray(s, -1.0, m);
+    w->linsys->accumByA(w->A, w->p, w->u, s);
+    scaleArray(s, -1.0, m);
+    for (i = 0; i < m; ++i) {
+        if (active[i]) {
+            s[i] = 0;
+        }
+    }
+    /* y onto K*, s onto K via s + Pi_K*(-s) */
+    projDualCone(y, k, w->coneWork, SCS_NULL, -1);
+    memcpy(z, s, m * sizeof(scs_float));
+    scaleArray(z, -1.0, m);
+    projDualCone(z, k, w->coneWork, SCS_NULL, -1);
+    addScaledArray(s, z, m, 1.0);
+    w->AxIter = -1;
+    r->lastIter = -1;
+    calcResiduals(w, w->u, w->v, r, iter);
+    after = MAX(MAX(r->resPri, r->resDual), r->relGap);
+    if (!(after < before)) {
+        memcpy(w->u, uOld, l * sizeof(scs_float));
+        memcpy(w->v, vOld, l * sizeof(scs_float));
+        r->lastIter = -1;
+    }
+    if (w->stgs->verbose) {
+        scs_printf("polish: max residual %1.2e -> %1.2e, %s\n", before, after,
+                   after < before ? "accepted" : "rejected");
+    }
+    scs_free(active);
+    scs_free(z);
+    RETURN;
+}
+
+#if ASYNC_RESID > 0
+#define ASYNC_IDLE (0) /* no check pending, snapshot free */
+#define ASYNC_BUSY (1) /* helper is computing the residuals of the snapshot */
+#define ASYNC_DONE (2) /* result ready to be collected by the main loop */
+#define ASYNC_QUIT (3) /* helper should exit */
+
+/* convergence check of a snapshot of the iterates, computed concurrently with
+ * the main loop by a helper thread */
+struct ASYNC_RESID_WORK {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    scs_int state;      /* one of the ASYNC_* states, guarded by lock */
+    scs_float *u, *v;   /* snapshot of the iterates */
+    scs_int iter;       /* iteration of the snapshot */
+    struct residuals r; /* residuals of the snapshot */
+    scs_int status;     /* hasConverged of the snapshot */
+};
+
+static void *asyncResidThread(void *arg) {
+    Work *w = (Work *)arg;
+    AsyncResid *a = w->async;
+    pthread_mutex_lock(&a->lock);
+    for (;;) {
+        while (a->state != ASYNC_BUSY && a->state != ASYNC_QUIT) {
+            pthread_cond_wait(&a->cond, &a->lock);
+        }
+        if (a->state == ASYNC_QUIT) {
+            break;
+        }
+        pthread_mutex_unlock(&a->lock);
+        a->r.lastIter = -1;
+        calcResiduals(w, a->u, a->v, &a->r, a->iter);
+        a->status = hasConverged(w, &a->r, a->iter);
+        pthread_mutex_lock(&a->lock);
+        a->state = ASYNC_DONE;
+        pthread_cond_broadcast(&a->cond);
+    }
+    pthread_mutex_unlock(&a->lock);
+    return SCS_NULL;
+}
+
+static void freeAsyncResid(AsyncResid *a) {
+    if (a->u)
+        scs_free(a->u);
+    if (a->v)
+        scs_free(a->v);
+    scs_free(a);
+}
+
+/* starts the helper thread, on failure w->async is left SCS_NULL and the
+ * residuals are computed synchronously */
+static void startAsyncResid(Work *w) {
+    scs_int l = w->n + w->m + 1;
+    AsyncResid *a = scs_calloc(1, sizeof(AsyncResid));
+    w->async = SCS_NULL;
+    if (!a) {
+        return;
+    }
+    a->u = scs_malloc(l * sizeof(scs_float));
+    a->v = scs_malloc(l * sizeof(scs_float));
+    if (!a->u || !a->v) {
+        freeAsyncResid(a);
+        return;
+    }
+    a->state = ASYNC_IDLE;
+    pthread_mutex_init(&a->lock, SCS_NULL);
+    pthread_cond_init(&a->cond, SCS_NULL);
+    w->async = a;
+    if (pthread_create(&a->thread, SCS_NULL, asyncResidThread, w) != 0) {
+        pthread_mutex_destroy(&a->lock);
+        pthread_cond_destroy(&a->cond);
+        freeAsyncResid(a);
+        w->async = SCS_NULL;
+    }
+}
+
+static void stopAsyncResid(Work *w) {
+    AsyncResid *a = w->async;
+    if (!a) {
+        return;
+    }
+    pthread_mutex_lock(&a->lock);
+    a->state = ASYNC_QUIT;
+    pthread_cond_broadcast(&a->cond);
+    pthread_mutex_unlock(&a->lock);
+    pthread_join(a->thread, SCS_NULL);
+    pthread_mutex_destroy(&a->lock);
+    pthread_cond_destroy(&a->cond);
+    freeAsyncResid(a);
+    w->async = SCS_NULL;
+}
+
+/* snapshots u, v of iteration iter and hands them to the helper, the helper
+ * must be idle */
+static void postAsyncResid(Work *w, scs_int iter) {
+    AsyncResid *a = w->async;
+    scs_int l = w->n + w->m + 1;
+    memcpy(a->u, w->u, l * sizeof(scs_float));
+    memcpy(a->v, w->v, l * sizeof(scs_float));
+    a->iter = iter;
+    a->r.fpr = calcFpr(w);
+    pthread_mutex_lock(&a->lock);
+    a->state = ASYNC_BUSY;
+    pthread_cond_broadcast(&a->cond);
+    pthread_mutex_unlock(&a->lock);
+}
+
+/* waits for the result of the posted check, if any, schedules the next check
+ * and adapts alpha and the scale from it, the scale is thus updated one
+ * iteration later than by the synchronous check; returns the termination
+ * status of the snapshot or SCS_FAILED if the rescale fails */
+static scs_int collectAsyncResid(Work *w, timer *solveTimer) {
+    AsyncResid *a = w->async;
+    scs_int state;
+    pthread_mutex_lock(&a->lock);
+    while (a->state == ASYNC_BUSY) {
+        pthread_cond_wait(&a->cond, &a->lock);
+    }
+    state = a->state;
+    a->state = ASYNC_IDLE;
+    pthread_mutex_unlock(&a->lock);
+    if (state != ASYNC_DONE) {
+        return 0;
+    }
+    if (a->status) {
+        return a->status;
+    }
+    if (w->stgs->verbose && a->iter % PRINT_INTERVAL == 0) {
+        printSummary(w, a->iter, &a->r, solveTimer);
+    }
+    setNextCheck(w, &a->r, a->iter);
+    w->stalled = isStalled(w, &a->r, a->iter);
+    adaptAlpha(w, &a->r, a->iter);
+    if (!w->stalled && adaptScale(w, &a->r, a->iter) < 0) {
+        return SCS_FAILED;
+    }
+    return 0;
+}
+
+/* ends the helper at termination, if the last posted check succeeded the
+ * iterates are rolled back to its snapshot and its iteration is returned */
+static scs_int finishAsyncResid(Work *w, Info *info, timer *solveTimer,
+                                scs_int iter) {
+    AsyncResid *a = w->async;
+    scs_int l = w->n + w->m + 1;
+    if (!info->statusVal) {
+        info->statusVal = collectAsyncResid(w, solveTimer);
+    }
+    if (info->statusVal) {
+        memcpy(w->u, a->u, l * sizeof(scs_float));
+        memcpy(w->v, a->v, l * sizeof(scs_float));
+        iter = a->iter;
+    }
+    stopAsyncResid(w);
+    return iter;
+}
+#endif
+
+/* scs_solve without the ctrl-c listener, which the caller holds */
+static scs_int solve(Work *w, const Data *d, const Cone *k, Sol *sol,
+                     Info *info) {
+    DEBUG_FUNC
+    scs_int i, check;
+#if ASYNC_RESID > 0
+    scs_int pending = 0; /* a check was posted on the last iteration */
+#endif
     timer solveTimer;
     struct residuals r;
     if (!d || !k || !sol || !info || !w || !d->b || !d->c) {
         scs_printf("ERROR: SCS_NULL input\n");
         RETURN SCS_FAILED;
     }
-    /* initialize ctrl-c support */
-    startInterruptListener();
     tic(&solveTimer);
     info->statusVal = SCS_UNFINISHED; /* not yet converged */
     r.lastIter = -1;
+    w->AxIter = -1;
+    w->nextCheck = 0;
+    w->lastCheck = -1;
+    w->lastProgress = INFINITY;
+    w->stallEnd = STALL_START;
+    w->stalled = 0;
+    w->stallRef = w->stallBest = INFINITY;
+    w->stallRefFpr = w->stallBestFpr = INFINITY;
+    w->rescales = 0;
+    w->lastRescale = 0;
+    w->logRatioSum = 0;
+    w->logRatioCount = 0;
+    w->alpha = w->stgs->alpha;
+    w->alphaDir = 1;
+    w->alphaIter = -1;
+    w->alphaRate = INFINITY;
     updateWork(d, w, sol);
 
     if (w->stgs->verbose)
         printHeader(w, k);
+#if ASYNC_RESID > 0
+    startAsyncResid(w);
+#endif
     /* scs: */
     for (i = 0; i < w->stgs->max_iters; ++i) {
         memcpy(w->u_prev, w->u, (w->n + w->m + 1) * sizeof(scs_float));
+#if ASYNC_RESID > 0
+        if (pending && w->stgs->verbose && i % PRINT_INTERVAL == 0) {
+            /* collect early so that no printed row is skipped */
+            pending = 0;
+            info->statusVal = collectAsyncResid(w, &solveTimer);
+            if (info->statusVal || w->stalled) {
+                break;
+            }
+        }
+#endif
+        check = isCheckIter(w, i);
+#if ASYNC_RESID > 0
+        /* the helper reads pr, which a checked iteration overwrites */
+        check = check && !pending;
+#endif
 
-        if (projectLinSys(w, i) < 0) {
+        if (projectLinSys(w, i, check) < 0) {
+#if ASYNC_RESID > 0
+            stopAsyncResid(w);
+#endif
             RETURN failure(w, w->m, w->n, sol, info, SCS_FAILED,
                            "error in projectLinSys", "Failure");
         }
-        if (projectCones(w, k, i) < 0) {
+        if (projectConesAndUpdateDualVars(w, k, i) < 0) {
+#if ASYNC_RESID > 0
+            stopAsyncResid(w);
+#endif
             RETURN failure(w, w->m, w->n, sol, info, SCS_FAILED,
                            "error in projectCones", "Failure");
         }
 
-        updateDualVars(w);
-
         if (isInterrupted()) {
+#if ASYNC_RESID > 0
+            stopAsyncResid(w);
+#endif
             RETURN failure(w, w->m, w->n, sol, info, SCS_SIGINT, "Interrupted",
                            "Interrupted");
         }
-        if (i % CONVERGED_INTERVAL == 0) {
-            calcResiduals(w, &r, i);
+        if (w->cancel && LOAD_FLAG(w->cancel)) {
+#if ASYNC_RESID > 0
+            stopAsyncResid(w);
+#endif
+            populateOnFailure(w->m, w->n, sol, info, SCS_SIGINT, "Cancelled");
+            RETURN SCS_SIGINT;
+        }
+#if ASYNC_RESID > 0
+        if (w->async) {
+            /* the check of the last iteration ran alongside this one, so it
+             * ends the solve at most one iteration late */
+            if (pending) {
+                pending = 0;
+                info->statusVal = collectAsyncResid(w, &solveTimer);
+                if (info->statusVal || w->stalled) {
+                    break;
+                }
+            }
+            if (check) {
+                postAsyncResid(w, i);
+                pending = 1;
+            }
+            continue;
+        }
+#endif
+        if (check) {
+            calcResiduals(w, w->u, w->v, &r, i);
+            r.fpr = calcFpr(w);
             if ((info->statusVal = hasConverged(w, &r, i)) != 0) {
                 break;
             }
+            if (w->stgs->verbose && i % PRINT_INTERVAL == 0) {
+                printSummary(w, i, &r, &solveTimer);
+            }
+            setNextCheck(w, &r, i);
+            if ((w->stalled = isStalled(w, &r, i)) != 0) {
+                break;
+            }
+            adaptAlpha(w, &r, i);
+            if (adaptScale(w, &r, i) < 0) {
+                RETURN failure(w, w->m, w->n, sol, info, SCS_FAILED,
+                               "error in updateLinSys", "Failure");
+            }
         }
-
-        if (w->stgs->verbose && i % PRINT_INTERVAL == 0) {
-            calcResiduals(w, &r, i);
-            printSummary(w, i, &r, &solveTimer);
+    }
+#if ASYNC_RESID > 0
+    if (w->async) {
+        i = finishAsyncResid(w, info, &solveTimer, i);
+        if (info->statusVal == SCS_FAILED) {
+            RETURN failure(w, w->m, w->n, sol, info, SCS_FAILED,
+                           "error in updateLinSys", "Failure");
         }
     }
+#endif
+    if (w->stgs->polish && info->statusVal == SCS_SOLVED) {
+        polish(w, k, &r, i);
+    }
     if (w->stgs->verbose) {
-        calcResiduals(w, &r, i);
+        calcResiduals(w, w->u, w->v, &r, i);
         printSummary(w, i, &r, &solveTimer);
     }
-    /* populate solution vectors (unnormalized) and info */
+    /* populate solution vectors (unnormalized) and info, the residuals are
+     * recomputed here on the returned iterate so an asynchronous check is
+     * re-verified */
     getSolution(w, sol, info, &r, i);
     info->solveTime = tocq(&solveTimer);
 
     if (w->stgs->verbose)
         printFooter(d, k, sol, w, info);
-    endInterruptListener();
     RETURN info->statusVal;
 }
 
+scs_int scs_solve(Work *w, const Data *d, const Cone *k, Sol *sol, Info *info) {
+    DEBUG_FUNC
+    scs_int status;
+    /* initialize ctrl-c support */
+    startInterruptListener();
+    status = solve(w, d, k, sol, info);
+    endInterruptListener();
+    RETURN status;
+}
+
 void scs_finish(Work *w) {
     DEBUG_FUNC
     if (w) {
         finishCone(w->coneWork);
         if (w->stgs && w->stgs->normalize) {
 #ifndef COPYAMATRIX
-            unNormalizeA(w->A, w->stgs, w->scal);
+            unNormalizeA(w->A, w->scale, w->scal);
 #else
             freeAMatrix(w->A);
 #endif
         }
         if (w->p)
-            freePriv(w->p);
+            w->linsys->freePriv(w->p);
         freeWork(w);
     }
 #if EXTRAVERBOSE > 0
@@ -885,14 +1570,36 @@ void scs_finish(Work *w) {
     RETURN;
 }
 
-Work *scs_init(const Data *d, const Cone *k, Info *info) {
+scs_int scs_update_A(Work *w, const Data *d, const Cone *k) {
     DEBUG_FUNC
-#if EXTRAVERBOSE > 1
-    tic(&globalTimer);
+    scs_int copied = 0;
+    if (!w || !d || !k) {
+        scs_printf("ERROR: Missing Work, Data or Cone input\n");
+        RETURN - 1;
+    }
+#ifdef COPYAMATRIX
+    copied = w->stgs->normalize;
 #endif
+    /* w->A is either a copy of A or A itself */
+    if (copied ? copyAMatrixValues(w->A, d->A) < 0 : w->A != d->A) {
+        scs_printf("ERROR: A does not match the one of scs_init\n");
+        RETURN - 1;
+    }
+    if (w->stgs->normalize) {
+        scs_free(w->scal->D);
+        scs_free(w->scal->E);
+        normalizeA(w->A, w->scale, k, w->scal);
+    }
+    /* the cached A * x is stale, b, c and g are redone by the next solve */
+    w->AxIter = -1;
+    RETURN w->linsys->updateLinSys(w->A, w->stgs, w->p);
+}
+
+/* scs_init without the ctrl-c listener, which the caller holds */
+static Work *init(const Data *d, const Cone *k, Info *info) {
+    DEBUG_FUNC
     Work *w;
     timer initTimer;
-    startInterruptListener();
     if (!d || !k || !info) {
         scs_printf("ERROR: Missing Data, Cone or Info input\n");
         RETURN SCS_NULL;
@@ -914,6 +1621,17 @@ Work *scs_init(const Data *d, const Cone *k, Info *info) {
     if (d->stgs->verbose) {
         scs_printf("Setup time: %1.2es\n", info->setupTime / 1e3);
     }
+    RETURN w;
+}
+
+Work *scs_init(const Data *d, const Cone *k, Info *info) {
+    DEBUG_FUNC
+#if EXTRAVERBOSE > 1
+    tic(&globalTimer);
+#endif
+    Work *w;
+    startInterruptListener();
+    w = init(d, k, info);
     endInterruptListener();
     RETURN w;
 }
@@ -937,3 +1655,149 @@ scs_int scs(const Data *d, const Cone *k, Sol *sol, Info *info) {
     scs_finish(w);
     RETURN status;
 }
+
+#if RACE > 0
+/* state shared by the configurations of a race */
+typedef struct {
+    const Cone *k;
+    pthread_mutex_t lock;
+    scs_int cancel; /* set once a configuration has converged, a flag */
+    scs_int winner;          /* first configuration to converge, -1 if none */
+    scs_int first; /* first configuration to finish uncancelled, -1 if none */
+} Race;
+
+/* one configuration of a race, run on its own thread */
+typedef struct {
+    Race *race;
+    scs_int idx;
+    Data d; /* the caller's data with this configuration's settings */
+    Settings stgs;
+    Sol *sol;
+    Info info;
+} RaceEntry;
+
+static scs_int isConvergedStatus(scs_int statusVal) {
+    return statusVal == SCS_SOLVED || statusVal == SCS_INFEASIBLE ||
+           statusVal == SCS_UNBOUNDED;
+}
+
+static void *raceThread(void *arg) {
+    RaceEntry *e = (RaceEntry *)arg;
+    Race *race = e->race;
+    Work *w = SCS_NULL;
+    /* a configuration still setting up when another converges stops there */
+    if (!LOAD_FLAG(&race->cancel)) {
+        w = init(&(e->d), race->k, &(e->info));
+    }
+    if (w && !LOAD_FLAG(&race->cancel)) {
+        w->cancel = &(race->cancel);
+        solve(w, &(e->d), race->k, e->sol, &(e->info));
+    } else if (LOAD_FLAG(&race->cancel)) {
+        populateOnFailure(e->d.m, e->d.n, e->sol, &(e->info), SCS_SIGINT,
+                          "Cancelled");
+    } else {
+        populateOnFailure(e->d.m, e->d.n, e->sol, &(e->info), SCS_FAILED,
+                          "Failure");
+    }
+    scs_finish(w);
+    pthread_mutex_lock(&race->lock);
+    if (race->first < 0 && e->info.statusVal != SCS_SIGINT) {
+        race->first = e->idx;
+    }
+    if (race->winner < 0 && isConvergedStatus(e->info.statusVal)) {
+        race->winner = e->idx;
+        STORE_FLAG(&race->cancel, 1);
+    }
+    pthread_mutex_unlock(&race->lock);
+    return SCS_NULL;
+}
+
+static void copySolArray(scs_float **dst, const scs_float *src, scs_int len) {
+    if (src && len > 0) {
+        *dst = scs_malloc(len * sizeof(scs_float));
+        memcpy(*dst, src, len * sizeof(scs_float));
+    }
+}
+
+/* moves the array into the caller's one if allocated, else hands it over */
+static void moveSolArray(scs_float **dst, scs_float **src, scs_int len) {
+    if (*dst && *src) {
+        memcpy(*dst, *src, len * sizeof(scs_float));
+    } else if (*src) {
+        *dst = *src;
+        *src = SCS_NULL;
+    }
+}
+
+scs_int scs_race(const Data *d, const Cone *k, const Settings *stgs,
+                 scs_int num, Sol *sol, Info *info) {
+    DEBUG_FUNC
+    Race race;
+    RaceEntry *e;
+    pthread_t *threads;
+    scs_int i, best, *started;
+    if (!d || !k || !stgs || num <= 0 || !sol || !info) {
+        scs_printf("ERROR: SCS_NULL input\n");
+        RETURN - 1;
+    }
+#ifndef COPYAMATRIX
+    /* without a copy A is normalized in place, and it is shared */
+    for (i = 0; i < num; ++i) {
+        if (stgs[i].normalize) {
+            scs_printf("ERROR: racing with normalize needs COPYAMATRIX\n");
+            RETURN - 1;
+        }
+    }
+#endif
+    e = scs_calloc(num, sizeof(RaceEntry));
+    threads = scs_malloc(num * sizeof(pthread_t));
+    started = scs_calloc(num, sizeof(scs_int));
+    race.k = k;
+    race.cancel = 0;
+    race.winner = -1;
+    race.first = -1;
+    pthread_mutex_init(&race.lock, SCS_NULL);
+    /* one listener for all the configurations, ctrl-c stops each of them */
+    startInterruptListener();
+    for (i = 0; i < num; ++i) {
+        e[i].race = &race;
+        e[i].idx = i;
+        e[i].stgs = stgs[i];
+        e[i].d = *d;
+        e[i].d.stgs = &(e[i].stgs);
+        e[i].sol = scs_calloc(1, sizeof(Sol));
+        if (stgs[i].warm_start) {
+            copySolArray(&(e[i].sol->x), sol->x, d->n);
+            copySolArray(&(e[i].sol->y), sol->y, d->m);
+            copySolArray(&(e[i].sol->s), sol->s, d->m);
+        }
+        started[i] =
+            pthread_create(&threads[i], SCS_NULL, raceThread, &e[i]) == 0;
+        if (!started[i]) {
+            /* no thread to spare, run it here */
+            raceThread(&e[i]);
+        }
+    }
+    for (i = 0; i < num; ++i) {
+        if (started[i]) {
+            pthread_join(threads[i], SCS_NULL);
+        }
+    }
+    endInterruptListener();
+    pthread_mutex_destroy(&race.lock);
+
+    /* the first to converge, else the first to finish */
+    best = race.winner >= 0 ? race.winner : (race.first >= 0 ? race.first : 0);
+    *info = e[best].info;
+    moveSolArray(&(sol->x), &(e[best].sol->x), d->n);
+    moveSolArray(&(sol->y), &(e[best].sol->y), d->m);
+    moveSolArray(&(sol->s), &(e[best].sol->s), d->m);
+    for (i = 0; i < num; ++i) {
+        freeSol(e[i].sol);
+    }
+    scs_free(e);
+    scs_free(threads);
+    scs_free(started);
+    RETURN best;
+}
+#endif
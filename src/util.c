@@ -79,11 +79,21 @@ void printConeData(const Cone *k) {
     scs_int i;
     scs_printf("num zeros = %i\n", (int)k->f);
     scs_printf("num LP = %i\n", (int)k->l);
+    scs_printf("num box = %i\n", (int)k->bsize);
+    scs_printf("box bounds:\n");
+    for (i = 0; i < k->bsize - 1; i++) {
+        scs_printf("[%4f, %4f]\n", (double)k->bl[i], (double)k->bu[i]);
+    }
     scs_printf("num SOCs = %i\n", (int)k->qsize);
     scs_printf("soc array:\n");
     for (i = 0; i < k->qsize; i++) {
         scs_printf("%i\n", (int)k->q[i]);
     }
+    scs_printf("num rotated SOCs = %i\n", (int)k->rsize);
+    scs_printf("rotated soc array:\n");
+    for (i = 0; i < k->rsize; i++) {
+        scs_printf("%i\n", (int)k->r[i]);
+    }
     scs_printf("num SDCs = %i\n", (int)k->ssize);
     scs_printf("sdc array:\n");
     for (i = 0; i < k->ssize; i++) {
@@ -122,6 +132,11 @@ void printData(const Data *d) {
     scs_printf("verbose = %i\n", (int)d->stgs->verbose);
     scs_printf("normalize = %i\n", (int)d->stgs->normalize);
     scs_printf("warmStart = %i\n", (int)d->stgs->warm_start);
+    scs_printf("polish = %i\n", (int)d->stgs->polish);
+    scs_printf("adapt_scale = %i\n", (int)d->stgs->adapt_scale);
+    scs_printf("adapt_alpha = %i\n", (int)d->stgs->adapt_alpha);
+    scs_printf("stall_stop = %i\n", (int)d->stgs->stall_stop);
+    scs_printf("linsys = %i\n", (int)d->stgs->linsys);
     scs_printf("eps = %4f\n", d->stgs->eps);
     scs_printf("alpha = %4f\n", d->stgs->alpha);
     scs_printf("rhoX = %4f\n", d->stgs->rho_x);
@@ -162,10 +177,16 @@ void freeData(Data *d, Cone *k) {
     if (k) {
         if (k->q)
             scs_free(k->q);
+        if (k->r)
+            scs_free(k->r);
         if (k->s)
             scs_free(k->s);
         if (k->p)
             scs_free(k->p);
+        if (k->bl)
+            scs_free(k->bl);
+        if (k->bu)
+            scs_free(k->bu);
         scs_free(k);
     }
 }
@@ -185,11 +206,69 @@ void freeSol(Sol *sol) {
     }
 }
 
+scs_int readSettings(Settings *stgs, const char *filename) {
+    char name[32];
+    double val;
+    int c;
+    FILE *fp = fopen(filename, "r");
+    if (!fp) {
+        scs_printf("couldn't open settings file %s\n", filename);
+        return -1;
+    }
+    while (fscanf(fp, " %31s", name) == 1) {
+        if (name[0] == '#') {
+            while ((c = fgetc(fp)) != EOF && c != '\n')
+                ;
+            continue;
+        }
+        if (fscanf(fp, "%lf", &val) != 1) {
+            scs_printf("no value for setting %s in %s\n", name, filename);
+            fclose(fp);
+            return -1;
+        }
+        if (strcmp(name, "normalize") == 0) {
+            stgs->normalize = (scs_int)val;
+        } else if (strcmp(name, "scale") == 0) {
+            stgs->scale = (scs_float)val;
+        } else if (strcmp(name, "rho_x") == 0) {
+            stgs->rho_x = (scs_float)val;
+        } else if (strcmp(name, "max_iters") == 0) {
+            stgs->max_iters = (scs_int)val;
+        } else if (strcmp(name, "eps") == 0) {
+            stgs->eps = (scs_float)val;
+        } else if (strcmp(name, "alpha") == 0) {
+            stgs->alpha = (scs_float)val;
+        } else if (strcmp(name, "cg_rate") == 0) {
+            stgs->cg_rate = (scs_float)val;
+        } else if (strcmp(name, "verbose") == 0) {
+            stgs->verbose = (scs_int)val;
+        } else if (strcmp(name, "warm_start") == 0) {
+            stgs->warm_start = (scs_int)val;
+        } else if (strcmp(name, "polish") == 0) {
+            stgs->polish = (scs_int)val;
+        } else if (strcmp(name, "adapt_scale") == 0) {
+            stgs->adapt_scale = (scs_int)val;
+        } else if (strcmp(name, "adapt_alpha") == 0) {
+            stgs->adapt_alpha = (scs_int)val;
+        } else if (strcmp(name, "stall_stop") == 0) {
+            stgs->stall_stop = (scs_int)val;
+        } else if (strcmp(name, "linsys") == 0) {
+            stgs->linsys = (scs_int)val;
+        } else {
+            scs_printf("unknown setting %s in %s\n", name, filename);
+            fclose(fp);
+            return -1;
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
 /* assumes d->stgs already allocated memory */
 void setDefaultSettings(Data *d) {
     d->stgs->max_iters = MAX_ITERS; /* maximum iterations to take: 2500 */
     d->stgs->eps = EPS;             /* convergence tolerance: 1e-3 */
-    d->stgs->alpha = ALPHA;         /* relaxation parameter: 1.8 */
+    d->stgs->alpha = ALPHA;         /* relaxation parameter: 1.5 */
     d->stgs->rho_x = RHO_X;         /* x equality constraint scaling: 1e-3 */
     d->stgs->scale = SCALE;     /* if normalized, rescales by this factor: 1 */
     d->stgs->cg_rate = CG_RATE; /* for indirect, tolerance goes down like
@@ -197,4 +276,9 @@ void setDefaultSettings(Data *d) {
     d->stgs->verbose = VERBOSE; /* boolean, write out progress: 1 */
     d->stgs->normalize = NORMALIZE; /* boolean, heuristic data rescaling: 1 */
     d->stgs->warm_start = WARM_START;
+    d->stgs->polish = POLISH; /* boolean, polish the solution: 0 */
+    d->stgs->adapt_scale = ADAPT_SCALE; /* max updates of scale, 0 is off: 0 */
+    d->stgs->adapt_alpha = ADAPT_ALPHA; /* boolean, adapt alpha: 0 */
+    d->stgs->stall_stop = STALL_STOP; /* boolean, stop on a stall: 0 */
+    d->stgs->linsys = LINSYS; /* linear system backend: LINSYS_AUTO */
 }